@@ -0,0 +1,63 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_ALLOCATE_WITH_H_
+#define _FRP_ALLOCATE_WITH_H_
+
+#include <frp/execute_on.h>
+#include <utility>
+
+namespace frp {
+namespace internal {
+
+template<typename F, typename A>
+struct allocate_with_type {
+	typedef A allocator_type;
+	typedef F function_type;
+
+	A allocator;
+	F function;
+};
+
+template<typename F, typename A>
+struct from_function_type<allocate_with_type<F, A>> {
+	typedef typename from_function_type<F>::executor_type executor_type;
+	typedef typename from_function_type<F>::function_type function_type;
+	typedef A allocator_type;
+
+	static decltype(auto) executor(allocate_with_type<F, A> &&f) {
+		return from_function_type<F>::executor(std::move(f.function));
+	}
+
+	static decltype(auto) function(allocate_with_type<F, A> &&f) {
+		return from_function_type<F>::function(std::move(f.function));
+	}
+
+	static decltype(auto) allocator(allocate_with_type<F, A> &&f) {
+		return std::move(f.allocator);
+	}
+};
+
+} // namespace internal
+
+// Makes map, filter and map_cache allocate the values they produce with a
+// rebound copy of allocator, e.g.
+// frp::stat::push::map(frp::allocate_with(allocator, function), dependency).
+// It can wrap, and be wrapped by, frp::execute_on.
+template<typename A, typename F>
+internal::allocate_with_type<F, A> allocate_with(A allocator, F function) {
+	return { std::forward<A>(allocator), std::forward<F>(function) };
+}
+
+} // namespace frp
+
+#endif // _FRP_ALLOCATE_WITH_H_
@@ -0,0 +1,676 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_DIFF_VECTOR_H_
+#define _FRP_DIFF_VECTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <frp/util/storage_ptr.h>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace frp {
+
+// A change made to a diff_vector_type, in the indices of the vector it was made
+// to.
+struct diff_type {
+	enum kind_type { insert, erase, update };
+
+	kind_type kind;
+	std::size_t index;
+	std::size_t count;
+};
+
+// Immutable vector that remembers how it was derived.
+//
+// Values are kept in a tree of up to 32 wide nodes, shared between the vectors
+// derived from each other. Branches keep the running sizes of their children,
+// so leaves need not be full; set, update, insert and erase copy only the path
+// to the leaves they touch, splitting the nodes that overflow. Each derived
+// vector records the change and the version it was made to, for the last
+// history_limit changes, so a repository that saw an earlier version can apply
+// only what changed since, see changes_since.
+template<typename T, typename Comparator = std::equal_to<T>>
+struct diff_vector_type {
+
+	typedef T value_type;
+	typedef Comparator comparator_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const value_type& reference;
+	typedef const value_type& const_reference;
+	typedef const value_type *pointer;
+	typedef const value_type *const_pointer;
+	typedef std::uint64_t version_type;
+
+	static constexpr size_type history_limit = 16;
+
+	struct iterator {
+		friend struct diff_vector_type<T, Comparator>;
+
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef T value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T *pointer;
+		typedef const T &reference;
+
+		iterator() = default;
+
+		auto &operator+=(difference_type difference) {
+			index += difference;
+			return *this;
+		}
+
+		auto &operator-=(difference_type difference) {
+			index -= difference;
+			return *this;
+		}
+
+		auto operator+(difference_type difference) const {
+			return iterator(vector, index + difference);
+		}
+
+		auto operator-(difference_type difference) const {
+			return iterator(vector, index - difference);
+		}
+
+		difference_type operator-(const iterator &it) const {
+			return difference_type(index) - difference_type(it.index);
+		}
+
+		const_reference operator[](difference_type offset) const {
+			return *(*this + offset);
+		}
+
+		bool operator<(const iterator &it) const {
+			return index < it.index;
+		}
+
+		bool operator>(const iterator &it) const {
+			return index > it.index;
+		}
+
+		bool operator<=(const iterator &it) const {
+			return index <= it.index;
+		}
+
+		bool operator>=(const iterator &it) const {
+			return index >= it.index;
+		}
+
+		bool operator==(const iterator &it) const {
+			return index == it.index;
+		}
+
+		bool operator!=(const iterator &it) const {
+			return index != it.index;
+		}
+
+		iterator &operator++() {
+			++index;
+			return *this;
+		}
+
+		iterator operator++(int) {
+			auto copy(*this);
+			++index;
+			return copy;
+		}
+
+		iterator &operator--() {
+			--index;
+			return *this;
+		}
+
+		iterator operator--(int) {
+			auto copy(*this);
+			--index;
+			return copy;
+		}
+
+		// The leaf is looked up again only when crossing into another one.
+		const_reference operator*() const {
+			if (!leaf || index < leaf_begin || index >= leaf_end) {
+				leaf = vector->find_leaf(index, leaf_begin, leaf_end);
+			}
+			return leaf[index - leaf_begin];
+		}
+
+		const_pointer operator->() const {
+			return &operator*();
+		}
+
+	private:
+		iterator(const diff_vector_type *vector, size_type index) : vector(vector), index(index) {}
+
+		const diff_vector_type *vector = nullptr;
+		size_type index = 0;
+		mutable const T *leaf = nullptr;
+		mutable size_type leaf_begin = 0;
+		mutable size_type leaf_end = 0;
+	};
+	typedef iterator const_iterator;
+	typedef std::reverse_iterator<iterator> reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	diff_vector_type() : current_version(next_version()) {}
+
+	diff_vector_type(std::initializer_list<T> values)
+		: diff_vector_type(values.begin(), values.end()) {}
+
+	template<typename ForwardIt>
+	diff_vector_type(ForwardIt first, ForwardIt last) : current_version(next_version()) {
+		storage_size = size_type(std::distance(first, last));
+		root = build(storage_size, height, [&](T *place) {
+			::new (place) T(*first++);
+		});
+	}
+
+	// A vector of count values, where f(index) returns the value at index.
+	template<typename F>
+	static diff_vector_type generate(size_type count, F &&f) {
+		diff_vector_type result;
+		size_type index(0);
+		result.storage_size = count;
+		result.root = build(count, result.height, [&](T *place) {
+			::new (place) T(f(index++));
+		});
+		return result;
+	}
+
+	const_reference operator[](size_type index) const {
+		assert(index < storage_size);
+		size_type leaf_begin, leaf_end;
+		return find_leaf(index, leaf_begin, leaf_end)[index - leaf_begin];
+	}
+
+	const_reference front() const {
+		return operator[](0);
+	}
+
+	const_reference back() const {
+		return operator[](storage_size - 1);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const {
+		return const_iterator(this, storage_size);
+	}
+
+	auto rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	auto rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	size_type size() const {
+		return storage_size;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	version_type version() const {
+		return current_version;
+	}
+
+	// The modifiers below leave this vector alone and return the changed copy.
+
+	template<typename U>
+	diff_vector_type set(size_type index, U &&value) const {
+		return update_n(index, 1, [&](size_type) -> U&& { return std::forward<U>(value); });
+	}
+
+	// Replaces the values in [index, index + count) with f(i) for each index i.
+	template<typename F>
+	diff_vector_type update_n(size_type index, size_type count, F &&f) const {
+		assert(index + count <= storage_size);
+		auto result(derive(diff_type{ diff_type::update, index, count }));
+		if (count > 0) {
+			result.root = update_node(root.get(), height, 0, index, index + count, f);
+		}
+		return result;
+	}
+
+	template<typename U>
+	diff_vector_type insert(size_type index, U &&value) const {
+		return insert_n(index, 1, [&](size_type) -> U&& { return std::forward<U>(value); });
+	}
+
+	template<typename ForwardIt>
+	diff_vector_type insert(size_type index, ForwardIt first, ForwardIt last) const {
+		return insert_n(index, size_type(std::distance(first, last)), [&](size_type) {
+			return *first++;
+		});
+	}
+
+	// Inserts count values before index, f(i) returning the value that ends up
+	// at index i.
+	template<typename F>
+	diff_vector_type insert_n(size_type index, size_type count, F &&f) const {
+		assert(index <= storage_size);
+		auto result(derive(diff_type{ diff_type::insert, index, count }));
+		if (count > 0) {
+			std::vector<node_ptr> nodes;
+			if (root) {
+				insert_node(root.get(), height, index, count, index, f, nodes);
+			} else {
+				nodes.push_back(build(count, result.height, [&](T *place) {
+					::new (place) T(f(index++));
+				}));
+			}
+			result.root = make_root(std::move(nodes), result.height);
+			result.storage_size += count;
+		}
+		return result;
+	}
+
+	template<typename U>
+	diff_vector_type push_back(U &&value) const {
+		return insert(storage_size, std::forward<U>(value));
+	}
+
+	diff_vector_type erase(size_type index, size_type count = 1) const {
+		assert(index + count <= storage_size);
+		auto result(derive(diff_type{ diff_type::erase, index, count }));
+		if (count > 0) {
+			result.root = erase_node(root.get(), height, index, index + count);
+			while (result.root && result.height > 0
+				&& static_cast<const branch_type *>(result.root.get())->count == 1) {
+				result.root = static_cast<const branch_type *>(result.root.get())->children[0];
+				--result.height;
+			}
+			if (!result.root) {
+				result.height = 0;
+			}
+			result.storage_size -= count;
+		}
+		return result;
+	}
+
+	// Appends the changes made since version to changes, oldest first. Returns
+	// false if version is not this vector or one of the history_limit vectors
+	// it was derived from.
+	bool changes_since(version_type version, std::vector<diff_type> &changes) const {
+		if (version == current_version) {
+			return true;
+		}
+		if (!history) {
+			return false;
+		}
+		for (auto entry = history->size; entry > 0; --entry) {
+			if (history->entries[entry - 1].version == version) {
+				for (auto next = entry - 1; next < history->size; ++next) {
+					changes.push_back(history->entries[next].change);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Shared nodes are equal without looking at their values.
+	bool operator==(const diff_vector_type &vector) const {
+		return size() == vector.size()
+			&& equal_nodes(root.get(), height, vector.root.get(), vector.height);
+	}
+
+	bool operator!=(const diff_vector_type &vector) const {
+		return !operator==(vector);
+	}
+
+private:
+	static constexpr size_type width = 32;
+
+	struct node_type : util::counted_type {};
+
+	typedef util::storage_ptr<const node_type> node_ptr;
+
+	struct leaf_type : node_type {
+		~leaf_type() {
+			for (size_type index = 0; index < size; ++index) {
+				slot(index)->~T();
+			}
+		}
+
+		T *slot(size_type index) {
+			return reinterpret_cast<T *>(&storage[index]);
+		}
+
+		const T *values() const {
+			return reinterpret_cast<const T *>(&storage[0]);
+		}
+
+		size_type size = 0;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[width];
+	};
+
+	struct branch_type : node_type {
+		size_type size() const {
+			return count ? sizes[count - 1] : 0;
+		}
+
+		size_type begin(size_type child) const {
+			return child ? sizes[child - 1] : 0;
+		}
+
+		void push_back(node_ptr child, size_type child_size) {
+			sizes[count] = size() + child_size;
+			children[count++] = std::move(child);
+		}
+
+		// The child holding index.
+		size_type find(size_type index) const {
+			return size_type(std::upper_bound(sizes, sizes + count, index) - sizes);
+		}
+
+		size_type count = 0;
+		// sizes[i] is the number of values in children[0] to children[i].
+		size_type sizes[width];
+		node_ptr children[width];
+	};
+
+	struct history_entry_type {
+		version_type version;
+		diff_type change;
+	};
+
+	// The last changes, oldest first; entries[i].change was made to the vector
+	// of entries[i].version.
+	struct history_type : util::counted_type {
+		size_type size = 0;
+		history_entry_type entries[history_limit];
+	};
+
+	static version_type next_version() {
+		static std::atomic<version_type> last(0);
+		return ++last;
+	}
+
+	static size_type node_size(const node_type *node, size_type height) {
+		return height ? static_cast<const branch_type *>(node)->size()
+			: static_cast<const leaf_type *>(node)->size;
+	}
+
+	const T *find_leaf(size_type index, size_type &leaf_begin, size_type &leaf_end) const {
+		const node_type *node(root.get());
+		leaf_begin = 0;
+		for (auto level = height; level > 0; --level) {
+			auto &branch(*static_cast<const branch_type *>(node));
+			auto child(branch.find(index - leaf_begin));
+			leaf_begin += branch.begin(child);
+			node = branch.children[child].get();
+		}
+		auto &leaf(*static_cast<const leaf_type *>(node));
+		leaf_end = leaf_begin + leaf.size;
+		return leaf.values();
+	}
+
+	diff_vector_type derive(const diff_type &change) const {
+		auto next(util::make_storage<history_type>());
+		auto kept(history ? std::min(history->size, history_limit - 1) : 0);
+		if (kept > 0) {
+			std::copy(history->entries + history->size - kept, history->entries + history->size,
+				next->entries);
+		}
+		next->entries[kept] = history_entry_type{ current_version, change };
+		next->size = kept + 1;
+
+		diff_vector_type result(*this);
+		result.current_version = next_version();
+		result.history = std::move(next);
+		return result;
+	}
+
+	// Groups nodes of one height into as few branches as fit them, evenly.
+	static std::vector<node_ptr> make_branches(std::vector<node_ptr> &&nodes, size_type height) {
+		auto count((nodes.size() + width - 1) / width);
+		std::vector<node_ptr> branches;
+		branches.reserve(count);
+		for (size_type branch_index = 0, index = 0; branch_index < count; ++branch_index) {
+			auto branch(util::make_storage<branch_type>());
+			auto end(index + nodes.size() / count + (branch_index < nodes.size() % count));
+			for (; index < end; ++index) {
+				auto size(node_size(nodes[index].get(), height));
+				branch->push_back(std::move(nodes[index]), size);
+			}
+			branches.push_back(std::move(branch));
+		}
+		return branches;
+	}
+
+	// Stacks branches on nodes of height until a single root is left.
+	static node_ptr make_root(std::vector<node_ptr> &&nodes, size_type &height) {
+		while (nodes.size() > 1) {
+			nodes = make_branches(std::move(nodes), height++);
+		}
+		return nodes.empty() ? node_ptr() : std::move(nodes.front());
+	}
+
+	// Builds a tree of size values, where next(place) constructs the next one at
+	// place.
+	template<typename Next>
+	static node_ptr build(size_type size, size_type &height, Next &&next) {
+		std::vector<node_ptr> leaves;
+		leaves.reserve((size + width - 1) / width);
+		for (size_type begin = 0; begin < size; begin += width) {
+			auto leaf(util::make_storage<leaf_type>());
+			for (auto end = std::min(size, begin + width); begin + leaf->size < end; ++leaf->size) {
+				next(leaf->slot(leaf->size));
+			}
+			leaves.push_back(std::move(leaf));
+		}
+		height = 0;
+		return make_root(std::move(leaves), height);
+	}
+
+	template<typename F>
+	static node_ptr update_node(const node_type *node, size_type height, size_type node_begin,
+			size_type begin, size_type end, F &f) {
+		if (height == 0) {
+			auto &values(*static_cast<const leaf_type *>(node));
+			auto leaf(util::make_storage<leaf_type>());
+			for (; leaf->size < values.size; ++leaf->size) {
+				auto index(node_begin + leaf->size);
+				if (index >= begin && index < end) {
+					::new (leaf->slot(leaf->size)) T(f(index));
+				} else {
+					::new (leaf->slot(leaf->size)) T(values.values()[leaf->size]);
+				}
+			}
+			return leaf;
+		}
+		auto &children(*static_cast<const branch_type *>(node));
+		auto branch(util::make_storage<branch_type>());
+		for (size_type child = 0; child < children.count; ++child) {
+			auto child_begin(node_begin + children.begin(child));
+			auto child_end(node_begin + children.sizes[child]);
+			if (child_begin < end && begin < child_end) {
+				branch->push_back(update_node(children.children[child].get(), height - 1,
+					child_begin, begin, end, f), child_end - child_begin);
+			} else {
+				branch->push_back(children.children[child], child_end - child_begin);
+			}
+		}
+		return branch;
+	}
+
+	// Appends the nodes replacing node, of the same height, to nodes: node with
+	// count values inserted before index, the value at index i of the vector
+	// being f(first + i - index).
+	template<typename F>
+	static void insert_node(const node_type *node, size_type height, size_type index,
+			size_type count, size_type first, F &f, std::vector<node_ptr> &nodes) {
+		if (height == 0) {
+			auto &values(*static_cast<const leaf_type *>(node));
+			auto total(values.size + count);
+			auto leaves((total + width - 1) / width);
+			for (size_type leaf_index = 0, position = 0; leaf_index < leaves; ++leaf_index) {
+				auto leaf(util::make_storage<leaf_type>());
+				auto end(position + total / leaves + (leaf_index < total % leaves));
+				for (; position < end; ++position, ++leaf->size) {
+					if (position < index) {
+						::new (leaf->slot(leaf->size)) T(values.values()[position]);
+					} else if (position < index + count) {
+						::new (leaf->slot(leaf->size)) T(f(first + position - index));
+					} else {
+						::new (leaf->slot(leaf->size)) T(values.values()[position - count]);
+					}
+				}
+				nodes.push_back(std::move(leaf));
+			}
+			return;
+		}
+		auto &branch(*static_cast<const branch_type *>(node));
+		auto child(std::min(branch.find(index), branch.count - 1));
+		std::vector<node_ptr> children(branch.children, branch.children + child);
+		insert_node(branch.children[child].get(), height - 1, index - branch.begin(child), count,
+			first, f, children);
+		children.insert(children.end(), branch.children + child + 1, branch.children + branch.count);
+		for (auto &replacement : make_branches(std::move(children), height - 1)) {
+			nodes.push_back(std::move(replacement));
+		}
+	}
+
+	// node without the values in [begin, end), or nothing if none are left.
+	static node_ptr erase_node(const node_type *node, size_type height, size_type begin,
+			size_type end) {
+		if (height == 0) {
+			auto &values(*static_cast<const leaf_type *>(node));
+			if (end - begin == values.size) {
+				return {};
+			}
+			auto leaf(util::make_storage<leaf_type>());
+			for (size_type index = 0; index < values.size; ++index) {
+				if (index < begin || index >= end) {
+					::new (leaf->slot(leaf->size++)) T(values.values()[index]);
+				}
+			}
+			return leaf;
+		}
+		auto &children(*static_cast<const branch_type *>(node));
+		auto branch(util::make_storage<branch_type>());
+		for (size_type child = 0; child < children.count; ++child) {
+			auto child_begin(children.begin(child)), child_end(children.sizes[child]);
+			if (child_end <= begin || child_begin >= end) {
+				branch->push_back(children.children[child], child_end - child_begin);
+			} else if (begin > child_begin || end < child_end) {
+				auto remaining(erase_node(children.children[child].get(), height - 1,
+					std::max(begin, child_begin) - child_begin,
+					std::min(end, child_end) - child_begin));
+				auto size(node_size(remaining.get(), height - 1));
+				branch->push_back(std::move(remaining), size);
+			}
+		}
+		if (branch->count == 0) {
+			return {};
+		}
+		return branch;
+	}
+
+	static void collect_leaves(const node_type *node, size_type height,
+			std::vector<const leaf_type *> &leaves) {
+		if (height == 0) {
+			leaves.push_back(static_cast<const leaf_type *>(node));
+			return;
+		}
+		auto &branch(*static_cast<const branch_type *>(node));
+		for (size_type child = 0; child < branch.count; ++child) {
+			collect_leaves(branch.children[child].get(), height - 1, leaves);
+		}
+	}
+
+	// Walks nodes of the same shape together; values are only compared where
+	// the nodes differ.
+	static bool equal_nodes(const node_type *first, size_type first_height,
+			const node_type *second, size_type second_height) {
+		if (first == second && first_height == second_height) {
+			return true;
+		}
+		if (!first || !second) {
+			return false;
+		}
+		if (first_height == second_height && first_height > 0) {
+			auto &first_branch(*static_cast<const branch_type *>(first));
+			auto &second_branch(*static_cast<const branch_type *>(second));
+			if (first_branch.count == second_branch.count && std::equal(first_branch.sizes,
+					first_branch.sizes + first_branch.count, second_branch.sizes)) {
+				for (size_type child = 0; child < first_branch.count; ++child) {
+					if (!equal_nodes(first_branch.children[child].get(), first_height - 1,
+							second_branch.children[child].get(), second_height - 1)) {
+						return false;
+					}
+				}
+				return true;
+			}
+		}
+
+		std::vector<const leaf_type *> first_leaves, second_leaves;
+		collect_leaves(first, first_height, first_leaves);
+		collect_leaves(second, second_height, second_leaves);
+		Comparator comparator;
+		size_type first_position(0), second_position(0);
+		auto second_leaf(second_leaves.begin());
+		for (auto first_leaf : first_leaves) {
+			for (first_position = 0; first_position < first_leaf->size; ++first_position) {
+				while (second_position == (*second_leaf)->size) {
+					++second_leaf;
+					second_position = 0;
+				}
+				if (!comparator(first_leaf->values()[first_position],
+						(*second_leaf)->values()[second_position++])) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	node_ptr root;
+	util::storage_ptr<const history_type> history;
+	size_type storage_size = 0;
+	size_type height = 0;
+	version_type current_version;
+};
+
+namespace internal {
+
+template<typename T>
+struct is_diff_vector : std::false_type {};
+
+template<typename T, typename Comparator>
+struct is_diff_vector<diff_vector_type<T, Comparator>> : std::true_type {};
+
+// True if every change refers to the indices of the last vector: updates never
+// move values, and a single insert or erase is the last change made.
+inline bool replayable(const std::vector<diff_type> &changes) {
+	return changes.size() == 1 || std::all_of(changes.begin(), changes.end(),
+		[](const diff_type &change) { return change.kind == diff_type::update; });
+}
+
+} // namespace internal
+} // namespace frp
+
+#endif // _FRP_DIFF_VECTOR_H_
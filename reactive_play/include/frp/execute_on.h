@@ -13,6 +13,10 @@
 #ifndef _FRP_EXECUTE_ON_H_
 #define _FRP_EXECUTE_ON_H_
 
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace frp {
@@ -32,12 +36,59 @@ struct execute_immediate_type {
 	void operator()(F f) const {
 		f();
 	}
+
+	template<typename F>
+	void for_range(std::size_t count, F &&f) const {
+		f(std::size_t(0), count);
+	}
 };
 
+template<typename E, typename = void>
+struct has_for_range : std::false_type {};
+
+template<typename E>
+struct has_for_range<E, decltype(std::declval<E &>().for_range(std::size_t(0),
+	std::declval<void (*)(std::size_t, std::size_t)>()))> : std::true_type {};
+
+template<typename E>
+const E &unwrap_executor(const E &executor) {
+	return executor;
+}
+
+template<typename E>
+E &unwrap_executor(const std::reference_wrapper<E> &executor) {
+	return executor.get();
+}
+
+template<typename E, typename F>
+std::enable_if_t<has_for_range<E>::value> for_range_on(E &executor, std::size_t count, F &&f) {
+	executor.for_range(count, std::forward<F>(f));
+}
+
+// Executors without for_range get one task per index.
+template<typename E, typename F>
+std::enable_if_t<!has_for_range<E>::value> for_range_on(E &executor, std::size_t count, F &&f) {
+	auto shared(std::make_shared<std::decay_t<F>>(std::forward<F>(f)));
+	for (std::size_t index = 0; index < count; ++index) {
+		executor([shared, index]() { (*shared)(index, index + 1); });
+	}
+}
+
+// Calls f(begin, end) for ranges covering [0, count) on executor, in as many
+// tasks as the executor chooses.
+template<typename E, typename F>
+void for_range(const E &executor, std::size_t count, F &&f) {
+	for_range_on(unwrap_executor(executor), count, std::forward<F>(f));
+}
+
+// Splits a function passed to a factory into the function itself, the
+// executor it runs on and the allocator for the values it produces. Wrappers
+// like execute_on_type defer to the function they wrap for the rest.
 template<typename F>
 struct from_function_type {
 	typedef execute_immediate_type executor_type;
 	typedef F function_type;
+	typedef std::allocator<char> allocator_type;
 
 	static auto executor(F &&f) {
 		return execute_immediate_type();
@@ -46,19 +97,28 @@ struct from_function_type {
 	static decltype(auto) function(F &&f) {
 		return std::forward<F>(f);
 	}
+
+	static auto allocator(F &&) {
+		return allocator_type();
+	}
 };
 
 template<typename F, typename E>
 struct from_function_type<execute_on_type<F, E>> {
 	typedef E executor_type;
-	typedef F function_type;
+	typedef typename from_function_type<F>::function_type function_type;
+	typedef typename from_function_type<F>::allocator_type allocator_type;
 
 	static decltype(auto) executor(execute_on_type<F, E> &&f) {
 		return std::move(f.executor);
 	}
 
 	static decltype(auto) function(execute_on_type<F, E> &&f) {
-		return std::move(f.function);
+		return from_function_type<F>::function(std::move(f.function));
+	}
+
+	static decltype(auto) allocator(execute_on_type<F, E> &&f) {
+		return from_function_type<F>::allocator(std::move(f.function));
 	}
 };
 
@@ -68,6 +128,14 @@ using get_executor_t = typename from_function_type<F>::executor_type;
 template<typename F>
 using get_function_t = typename from_function_type<F>::function_type;
 
+template<typename F>
+using get_allocator_t = typename from_function_type<F>::allocator_type;
+
+// The allocator for values of type T.
+template<typename F, typename T>
+using get_allocator_for_t = typename std::allocator_traits<get_allocator_t<F>>
+	::template rebind_alloc<T>;
+
 template<typename F>
 decltype(auto) get_executor(F &&f) {
 	return from_function_type<F>::executor(std::forward<F>(f));
@@ -78,6 +146,11 @@ decltype(auto) get_function(F &&f) {
 	return from_function_type<F>::function(std::forward<F>(f));
 }
 
+template<typename F>
+decltype(auto) get_allocator(F &&f) {
+	return from_function_type<F>::allocator(std::forward<F>(f));
+}
+
 } // namespace internal
 
 template<typename E, typename F>
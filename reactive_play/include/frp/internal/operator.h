@@ -21,6 +21,11 @@ auto get_storage(T &value)->decltype(value.get_storage()) {
 	return value.get_storage();
 }
 
+template<typename T>
+auto get_depth(T &value)->decltype(value.get_depth()) {
+	return value.get_depth();
+}
+
 } // namespace details
 } // namespace frp
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_STATIC_PULL_MAP_H_
+#define _FRP_STATIC_PULL_MAP_H_
+
+#include <frp/internal/namespace_alias.h>
+#include <frp/static/pull/repository.h>
+#include <frp/util/collector.h>
+#include <frp/vector_view.h>
+#include <iterator>
+
+namespace frp {
+namespace stat {
+namespace pull {
+
+// The values are mapped on the thread dereferencing a dependent sink, so an
+// executor given through frp::execute_on is not used; an allocator given
+// through frp::allocate_with is.
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto map(Function &&function, Dependencies... dependencies) {
+	static_assert(I < sizeof...(Dependencies),
+		"expanded index must be in the range of [0, arity) where arity = number of dependencies.");
+	static_assert(util::all_true_type<typename util::is_not_void<
+		typename util::unwrap_container_t<Dependencies>::value_type>::type...>::value,
+		"Dependencies can not be void type.");
+
+	typedef util::map_return_t<I, Function, Dependencies...> value_type;
+	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
+	static_assert(std::is_move_constructible<value_type>::value, "T must be move constructible");
+
+	typedef internal::get_allocator_for_t<Function, value_type> allocator_type;
+	typedef vector_view_type<value_type, Comparator, allocator_type> collector_view_type;
+	typedef util::commit_storage_type<collector_view_type, sizeof...(Dependencies)>
+		commit_storage_type;
+
+	return details::make_repository<collector_view_type, commit_storage_type,
+			std::equal_to<collector_view_type>>([
+				function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
+				allocator = allocator_type(internal::get_allocator(
+					util::unwrap_reference(std::forward<Function>(function))))](
+				const auto &current, const auto &revisions) {
+		typedef util::fixed_size_collector_type<value_type, Comparator, allocator_type>
+			collector_type;
+
+		auto &collection(std::get<I>(current)->value);
+		auto arguments(util::invoke([&](const auto&... storage) {
+			return std::tie(storage->value...);
+		}, current));
+		collector_type collector(collection.size(), allocator_type(allocator));
+		auto it(std::begin(collection));
+		for (std::size_t index = 0; index < collection.size(); ++index, ++it) {
+			collector.emplace(index, util::indexed_invoke_with_replacement<I>(function,
+				std::cref(*it), arguments));
+		}
+		collector.complete(collection.size());
+		return util::make_storage<commit_storage_type>(collector_view_type(std::move(collector)),
+			util::default_revision, revisions);
+	}, std::forward<Dependencies>(dependencies)...);
+}
+
+template<std::size_t I, typename Function, typename... Dependencies>
+auto map(Function &&function, Dependencies... dependencies) {
+	typedef util::map_return_t<I, Function, Dependencies...> value_type;
+	static_assert(util::is_equality_comparable<value_type>::value,
+		"T must implement equality comparator");
+	return pull::map<I, std::equal_to<value_type>>(std::forward<Function>(function),
+		std::forward<Dependencies>(dependencies)...);
+}
+
+template<typename Comparator, typename Function, typename... Dependencies>
+auto map(Function &&function, Dependencies... dependencies) {
+	return pull::map<0, Comparator>(std::forward<Function>(function),
+		std::forward<Dependencies>(dependencies)...);
+}
+
+template<typename Function, typename... Dependencies>
+auto map(Function &&function, Dependencies... dependencies) {
+	return pull::map<0>(std::forward<Function>(function),
+		std::forward<Dependencies>(dependencies)...);
+}
+
+} // namespace pull
+} // namespace stat
+} // namespace frp
+
+#endif // _FRP_STATIC_PULL_MAP_H_
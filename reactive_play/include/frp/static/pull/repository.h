@@ -0,0 +1,195 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_STATIC_PULL_REPOSITORY_H_
+#define _FRP_STATIC_PULL_REPOSITORY_H_
+
+#include <frp/execute_on.h>
+#include <frp/internal/namespace_alias.h>
+#include <frp/internal/operator.h>
+#include <frp/util/function.h>
+#include <frp/util/observable.h>
+#include <frp/util/observe_all.h>
+#include <frp/util/reference.h>
+#include <frp/util/storage.h>
+#include <frp/util/variadic.h>
+#include <frp/util/vector.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace frp {
+namespace stat {
+namespace pull {
+
+template<typename T>
+struct repository_type;
+
+namespace details {
+
+// A repository evaluated on demand.
+//
+// A change of any dependency only marks the node dirty, and tells its own
+// dependents the first time, so further writes stop at nodes already dirty.
+// get() evaluates a dirty node on the calling thread, after its dependencies.
+// A node whose dependencies kept their revisions is not evaluated again, and a
+// value equal to the previous one keeps its revision, so the nodes depending
+// on it are not evaluated either.
+template<typename Storage, typename Comparator, typename Generator, typename... Dependencies>
+struct node_type : util::observable_type {
+
+	typedef typename Storage::revisions_type revisions_type;
+
+	template<typename G, typename... Ds>
+	explicit node_type(G &&generator, Ds &&... dependencies)
+		: dependencies(std::forward<Ds>(dependencies)...)
+		, generator(std::forward<G>(generator)) {}
+
+	util::storage_ptr<Storage> get() {
+		if (dirty.load(std::memory_order_acquire)) {
+			std::lock_guard<std::mutex> lock(mutex);
+			// Cleared before the dependencies are read, so a write racing with
+			// the evaluation leaves the node dirty.
+			if (dirty.exchange(false)) {
+				evaluate();
+			}
+		}
+		return value.load();
+	}
+
+	void invalidate() {
+		if (!dirty.exchange(true)) {
+			update();
+		}
+	}
+
+	std::tuple<Dependencies...> dependencies;
+	std::vector<util::observable_type::reference_type> callbacks;
+
+private:
+	void evaluate() {
+		auto current(util::invoke([](const auto&... dependencies) {
+			return std::make_tuple(internal::get_storage(util::unwrap_container(dependencies))...);
+		}, dependencies));
+		bool available(util::invoke([](const auto&... storage) {
+			return util::all_true(storage...);
+		}, current));
+		if (!available) {
+			return;
+		}
+		auto revisions(util::invoke([](const auto&... storage) {
+			return revisions_type{ storage->revision... };
+		}, current));
+		auto last(value.load());
+		if (last && revisions == evaluated) {
+			return;
+		}
+
+		auto commit(generator(current, revisions));
+		evaluated = revisions;
+		if (!last || !commit->compare_value(*last, comparator)) {
+			commit->revision = (last ? last->revision : util::default_revision) + 1;
+			value.store(commit);
+		}
+	}
+
+	std::mutex mutex;
+	std::atomic_bool dirty{ true };
+	util::atomic_storage_ptr<Storage> value;
+	revisions_type evaluated{};
+	Generator generator;
+	Comparator comparator;
+};
+
+template<typename T, typename Storage, typename Comparator, typename Generator,
+	typename... Dependencies>
+repository_type<T> make_repository(Generator &&generator, Dependencies &&... dependencies);
+
+} // namespace details
+
+template<typename T>
+struct repository_type {
+
+	template<typename U, typename Storage, typename Comparator, typename Generator,
+		typename... Dependencies>
+	friend repository_type<U> details::make_repository(Generator &&generator,
+		Dependencies &&... dependencies);
+	template<typename O, typename F>
+	friend auto util::add_callback(O &observable, F &&f)
+		->decltype(observable.add_callback(std::forward<F>(f)));
+	template<typename U>
+	friend auto internal::get_storage(U &value)->decltype(value.get_storage());
+	template<typename U>
+	friend auto internal::get_depth(U &value)->decltype(value.get_depth());
+
+	typedef T value_type;
+
+	repository_type() = default;
+
+private:
+	template<typename Provider>
+	repository_type(const std::shared_ptr<util::observable_type> &observable,
+		Provider &&provider, std::size_t depth)
+		: provider(std::forward<Provider>(provider))
+		, observable(observable)
+		, depth(depth) {}
+
+	auto get_storage() const {
+		return provider();
+	}
+
+	std::size_t get_depth() const {
+		return depth;
+	}
+
+	template<typename F>
+	auto add_callback(F &&f) const {
+		return observable->add_callback(std::forward<F>(f));
+	}
+
+	std::function<util::storage_ptr<util::storage_type<T>>()> provider;
+	std::shared_ptr<util::observable_type> observable;
+	std::size_t depth = 0;
+};
+
+namespace details {
+
+template<typename T, typename Storage, typename Comparator, typename Generator,
+	typename... Dependencies>
+repository_type<T> make_repository(Generator &&generator, Dependencies &&... dependencies) {
+	typedef node_type<Storage, Comparator, std::decay_t<Generator>, Dependencies...>
+		repository_node_type;
+	auto node(std::make_shared<repository_node_type>(std::forward<Generator>(generator),
+		std::forward<Dependencies>(dependencies)...));
+	node->callbacks = util::vector_from_array(util::invoke(util::observe_all(
+		[weak_node = std::weak_ptr<repository_node_type>(node)]() {
+			auto node(weak_node.lock());
+			if (node) {
+				node->invalidate();
+			}
+		}), std::ref(node->dependencies)));
+	auto depth(1 + util::invoke([](const auto&... dependencies) {
+		return std::max({ std::size_t(0),
+			internal::get_depth(util::unwrap_container(dependencies))... });
+	}, node->dependencies));
+	return repository_type<T>(node, [node]() {
+		return util::storage_ptr<util::storage_type<T>>(node->get());
+	}, depth);
+}
+
+} // namespace details
+
+} // namespace pull
+} // namespace stat
+} // namespace frp
+
+#endif // _FRP_STATIC_PULL_REPOSITORY_H_
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_STATIC_PULL_SOURCE_H_
+#define _FRP_STATIC_PULL_SOURCE_H_
+
+#include <frp/internal/namespace_alias.h>
+#include <frp/internal/operator.h>
+#include <frp/util/observable.h>
+#include <frp/util/storage.h>
+#include <memory>
+#include <stdexcept>
+
+namespace frp {
+namespace stat {
+namespace pull {
+
+// Unlike frp::stat::push::source_type, a write is not compared with the
+// current value; it gets a new revision and only marks the dependents dirty.
+// Values equal to the previous one are told apart when the dependents are
+// evaluated.
+template<typename T>
+struct source_type {
+
+	template<typename U>
+	friend source_type<std::decay_t<U>> source();
+	template<typename U>
+	friend source_type<std::decay_t<U>> source(U &&value);
+	template<typename U>
+	friend source_type<std::decay_t<U>> source(const U &value);
+	template<typename O, typename F>
+	friend auto util::add_callback(O &observable, F &&f)
+		->decltype(observable.add_callback(std::forward<F>(f)));
+	template<typename U>
+	friend auto internal::get_storage(U &value)->decltype(value.get_storage());
+	template<typename U>
+	friend auto internal::get_depth(U &value)->decltype(value.get_depth());
+
+	typedef T value_type;
+
+	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
+	static_assert(std::is_move_constructible<value_type>::value, "T must be move constructible");
+
+private:
+	struct storage_type : util::observable_type {
+		storage_type() = default;
+		explicit storage_type(util::storage_ptr<util::storage_type<T>> &&value)
+			: value(std::forward<util::storage_ptr<util::storage_type<T>>>(value)) {}
+
+		void accept(util::storage_ptr<util::storage_type<T>> &&replacement) {
+			auto current(value.load());
+			do {
+				replacement->revision = (current ? current->revision : util::default_revision) + 1;
+			} while (!value.compare_exchange(current, replacement));
+			util::observable_type::update();
+		}
+
+		util::atomic_storage_ptr<util::storage_type<T>> value;
+	};
+
+	explicit source_type(std::unique_ptr<storage_type> &&storage)
+		: storage(std::forward<std::unique_ptr<storage_type>>(storage)) {}
+
+	auto get_storage() const {
+		return storage->value.load();
+	}
+
+	std::size_t get_depth() const {
+		return 0;
+	}
+
+	template<typename F>
+	auto add_callback(F &&f) const {
+		return storage->add_callback(std::forward<F>(f));
+	}
+
+	std::unique_ptr<storage_type> storage;
+
+public:
+	struct reference {
+
+		template<typename U>
+		friend struct source_type;
+
+		typedef T value_type;
+
+		operator bool() const {
+			return !!value;
+		}
+
+		const auto &operator*() const {
+			if (!value) {
+				throw std::domain_error("value not available");
+			}
+			else {
+				return value->value;
+			}
+		}
+
+		const auto operator->() const {
+			return &operator*();
+		}
+
+		operator const T &() const {
+			return operator*();
+		}
+
+		// The value, or nullptr if none is available yet.
+		const T *get() const {
+			return value ? &value->value : nullptr;
+		}
+
+	private:
+		explicit reference(util::storage_ptr<util::storage_type<T>> &&value)
+			: value(std::forward<util::storage_ptr<util::storage_type<T>>>(value)) {}
+		util::storage_ptr<util::storage_type<T>> value;
+	};
+
+	auto &operator=(T &&value) const {
+		storage->accept(util::make_storage<util::storage_type<T>>(std::forward<T>(value)));
+		return *this;
+	}
+
+	auto &operator=(const T &value) const {
+		storage->accept(util::make_storage<util::storage_type<T>>(value));
+		return *this;
+	}
+
+	reference operator*() const {
+		return reference(get_storage());
+	}
+};
+
+template<typename T>
+source_type<std::decay_t<T>> source() {
+	return source_type<std::decay_t<T>>(
+		std::make_unique<typename source_type<std::decay_t<T>>::storage_type>());
+}
+
+template<typename T>
+source_type<std::decay_t<T>> source(T &&value) {
+	typedef std::decay_t<T> value_type;
+	return source_type<value_type>(std::make_unique<typename source_type<value_type>::storage_type>(
+		util::make_storage<util::storage_type<value_type>>(std::forward<T>(value),
+			util::default_revision)));
+}
+
+template<typename T>
+source_type<std::decay_t<T>> source(const T &value) {
+	typedef std::decay_t<T> value_type;
+	return source_type<value_type>(std::make_unique<typename source_type<value_type>::storage_type>(
+		util::make_storage<util::storage_type<value_type>>(value, util::default_revision)));
+}
+
+} // namespace pull
+} // namespace stat
+} // namespace frp
+
+#endif // _FRP_STATIC_PULL_SOURCE_H_
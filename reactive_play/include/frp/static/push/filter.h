@@ -13,34 +13,148 @@
 #ifndef _FRP_STATIC_PUSH_FILTER_H_
 #define _FRP_STATIC_PUSH_FILTER_H_
 
+#include <bitset>
+#include <cstdint>
+#include <frp/diff_vector.h>
 #include <frp/internal/namespace_alias.h>
 #include <frp/static/push/repository.h>
 #include <frp/util/collector.h>
 #include <frp/vector_view.h>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 namespace frp {
 namespace stat {
 namespace push {
+namespace details {
+
+// One bit per filtered value, set if the value passed.
+struct filter_mask_type {
+
+	bool test(std::size_t index) const {
+		return (words[index / word_bits] >> (index % word_bits)) & 1;
+	}
+
+	void set(std::size_t index, bool passed) {
+		auto bit(std::uint64_t(1) << (index % word_bits));
+		if (passed) {
+			words[index / word_bits] |= bit;
+		} else {
+			words[index / word_bits] &= ~bit;
+		}
+	}
+
+	void push_back(bool passed) {
+		if (size % word_bits == 0) {
+			words.push_back(0);
+		}
+		set(size++, passed);
+	}
+
+	// The number of passed values in [begin, end).
+	std::size_t count(std::size_t begin, std::size_t end) const {
+		std::size_t result(0);
+		while (begin < end) {
+			auto offset(begin % word_bits);
+			auto length(std::min(word_bits - offset, end - begin));
+			auto bits(words[begin / word_bits] >> offset);
+			if (length < word_bits) {
+				bits &= (std::uint64_t(1) << length) - 1;
+			}
+			result += std::bitset<word_bits>(bits).count();
+			begin += length;
+		}
+		return result;
+	}
+
+	// Copies the bits, with count bits removed at index and the bits of
+	// inserted placed there instead.
+	filter_mask_type splice(std::size_t index, std::size_t count,
+			const std::vector<bool> &inserted) const {
+		filter_mask_type result;
+		result.words.reserve((size - count + inserted.size()) / word_bits + 1);
+		result.append(*this, 0, index);
+		for (auto passed : inserted) {
+			result.push_back(passed);
+		}
+		result.append(*this, index + count, size);
+		return result;
+	}
+
+	static constexpr std::size_t word_bits = 64;
+
+	std::vector<std::uint64_t> words;
+	std::size_t size = 0;
+
+private:
+	// Up to a word of bits starting at index.
+	std::uint64_t bits(std::size_t index, std::size_t length) const {
+		auto offset(index % word_bits);
+		auto result(words[index / word_bits] >> offset);
+		if (offset && offset + length > word_bits) {
+			result |= words[index / word_bits + 1] << (word_bits - offset);
+		}
+		return length < word_bits ? result & ((std::uint64_t(1) << length) - 1) : result;
+	}
+
+	void append(const filter_mask_type &mask, std::size_t begin, std::size_t end) {
+		while (begin < end) {
+			auto length(end - begin < word_bits ? end - begin : word_bits);
+			auto value(mask.bits(begin, length));
+			auto offset(size % word_bits);
+			if (offset == 0) {
+				words.push_back(value);
+			} else {
+				words.back() |= value << offset;
+				if (offset + length > word_bits) {
+					words.push_back(value >> (word_bits - offset));
+				}
+			}
+			size += length;
+			begin += length;
+		}
+	}
+};
+
+template<typename Container, std::size_t DependenciesN>
+struct filter_diff_commit_storage_type : util::commit_storage_type<Container, DependenciesN> {
+
+	typedef util::commit_storage_type<Container, DependenciesN> parent_type;
+	typedef typename parent_type::revisions_type revisions_type;
+	typedef typename Container::version_type version_type;
+
+	// The version of the filtered vector this value was filtered from, and which
+	// of its values passed.
+	version_type input_version;
+	std::shared_ptr<const filter_mask_type> mask;
+
+	filter_diff_commit_storage_type(Container &&value, util::revision_type revision,
+		const revisions_type &revisions, version_type input_version,
+		std::shared_ptr<const filter_mask_type> &&mask)
+		: parent_type(std::forward<Container>(value), revision, revisions)
+		, input_version(input_version)
+		, mask(std::move(mask)) {}
+};
 
 template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
-auto filter(Function &&function, Dependencies&&... dependencies) {
-	static_assert(I < sizeof...(Dependencies),
-		"expanded index must be in the range of [0, arity) where arity = number of dependencies.");
+auto filter(std::false_type, Function &&function, Dependencies&&... dependencies) {
 	typedef typename util::unwrap_reference_t<std::tuple_element_t<I, std::tuple<Dependencies...>>>
 		::value_type::value_type value_type;
-	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
-	static_assert(std::is_copy_constructible<value_type>::value, "T must be copy constructible.");
-	typedef vector_view_type<value_type, Comparator> collector_view_type;
+	typedef internal::get_allocator_for_t<Function, value_type> allocator_type;
+	typedef vector_view_type<value_type, Comparator, allocator_type> collector_view_type;
 	typedef util::commit_storage_type<collector_view_type, sizeof...(Dependencies)>
 		commit_storage_type;
 	typedef std::array<util::revision_type, sizeof...(Dependencies)> revisions_type;
 	return details::make_repository<collector_view_type, commit_storage_type,
 		std::equal_to<collector_view_type>>([
 			function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
-			executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+			executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function))),
+			allocator = allocator_type(internal::get_allocator(
+				util::unwrap_reference(std::forward<Function>(function))))](
 				auto &&callback, const auto &, const auto &dependencies) {
-			typedef util::append_collector_type<value_type, Comparator> collector_type;
+			typedef util::append_collector_type<value_type, Comparator, allocator_type>
+				collector_type;
 
 			auto values(util::invoke([&](const auto&... dependency) {
 				return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
@@ -50,27 +164,165 @@ auto filter(Function &&function, Dependencies&&... dependencies) {
 			}, values));
 			auto &collection(std::get<I>(values)->value);
 			if (collection.empty()) {
-				callback(std::make_shared<commit_storage_type>(
-					collector_view_type(collector_type(0)), util::default_revision, revisions));
+				callback(util::make_storage<commit_storage_type>(
+					collector_view_type(collector_type(0, allocator_type(allocator))),
+					util::default_revision, revisions));
 			} else {
-				auto collector(std::make_shared<collector_type>(collection.size()));
-				for (const auto &value : collection) {
-					executor([function, collector, &value, callback, values, revisions]() {
-						auto complete(util::indexed_invoke_with_replacement<I>(std::move(function),
-							std::cref(value), util::invoke([&](const auto&... values) {
-								return std::tie(values->value...);
-							}, values)));
-						if (complete ? collector->construct(std::ref(value)) : collector->skip()) {
-							callback(std::make_shared<commit_storage_type>(
-								collector_view_type(std::move(*collector)), util::default_revision,
-								revisions));
+				auto collector(std::allocate_shared<collector_type>(allocator, collection.size(),
+					allocator_type(allocator)));
+				internal::for_range(executor, collection.size(), [function, collector, &collection,
+						callback, values, revisions](std::size_t begin, std::size_t end) {
+					auto arguments(util::invoke([&](const auto&... values) {
+						return std::tie(values->value...);
+					}, values));
+					auto it(std::next(std::begin(collection), begin));
+					for (auto index = begin; index < end; ++index, ++it) {
+						if (util::indexed_invoke_with_replacement<I>(function, std::cref(*it),
+								arguments)) {
+							collector->emplace(std::ref(*it));
+						}
+					}
+					if (collector->complete(end - begin)) {
+						callback(util::make_storage<commit_storage_type>(
+							collector_view_type(std::move(*collector)), util::default_revision,
+							revisions));
+					}
+				});
+			}
+		}, std::forward<Dependencies>(dependencies)...);
+}
+
+// Filters a diff_vector_type into another one. When the other dependencies did
+// not change, only the values changed since the last filtered version are
+// tested again, and the result is changed where they passed or stopped passing.
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto filter(std::true_type, Function &&function, Dependencies&&... dependencies) {
+	typedef typename util::unwrap_reference_t<std::tuple_element_t<I, std::tuple<Dependencies...>>>
+		::value_type::value_type value_type;
+	typedef diff_vector_type<value_type, Comparator> container_type;
+	typedef filter_diff_commit_storage_type<container_type, sizeof...(Dependencies)>
+		commit_storage_type;
+	typedef typename commit_storage_type::revisions_type revisions_type;
+
+	return details::make_repository<container_type, commit_storage_type,
+		std::equal_to<container_type>>([
+			function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
+			executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+				auto &&callback, const auto &previous_storage, const auto &dependencies) {
+			executor([=, callback = std::move(callback)]() {
+				auto values(util::invoke([&](const auto&... dependency) {
+					return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
+				}, *dependencies));
+				auto revisions(util::invoke([&](const auto&... storage) {
+					return revisions_type{ storage->revision... };
+				}, values));
+				auto previous(previous_storage->load());
+				if (previous && !previous->is_newer(revisions)) {
+					return;
+				}
+
+				auto &collection(std::get<I>(values)->value);
+				auto arguments(util::invoke([&](const auto&... storage) {
+					return std::tie(storage->value...);
+				}, values));
+				auto passes([&](std::size_t index) -> bool {
+					return util::indexed_invoke_with_replacement<I>(function,
+						std::cref(collection[index]), arguments);
+				});
+
+				std::vector<diff_type> changes;
+				container_type result;
+				std::shared_ptr<filter_mask_type> mask;
+				if (previous && util::tuple_le_except_index<I>(revisions, previous->revisions)
+					&& collection.changes_since(previous->input_version, changes)
+					&& internal::replayable(changes)) {
+					result = previous->value;
+					auto &first(changes.front());
+					if (first.kind == diff_type::update) {
+						std::vector<std::size_t> updated;
+						for (const auto &change : changes) {
+							for (auto index = change.index; index < change.index + change.count; ++index) {
+								updated.push_back(index);
+							}
+						}
+						std::sort(updated.begin(), updated.end());
+						updated.erase(std::unique(updated.begin(), updated.end()), updated.end());
+
+						mask = std::make_shared<filter_mask_type>(*previous->mask);
+						// position is the index in result of the value at index, counted
+						// incrementally as updated is sorted.
+						std::size_t position(0), counted(0);
+						for (auto index : updated) {
+							position += mask->count(counted, index);
+							counted = index;
+							auto passed(mask->test(index)), passing(passes(index));
+							if (passed && passing) {
+								result = result.set(position, collection[index]);
+							} else if (passed) {
+								result = result.erase(position);
+							} else if (passing) {
+								result = result.insert(position, collection[index]);
+							}
+							mask->set(index, passing);
 						}
+					} else {
+						auto &previous_mask(*previous->mask);
+						auto position(previous_mask.count(0, first.index));
+						if (first.kind == diff_type::insert) {
+							std::vector<bool> inserted;
+							std::vector<std::size_t> passing;
+							for (auto index = first.index; index < first.index + first.count; ++index) {
+								inserted.push_back(passes(index));
+								if (inserted.back()) {
+									passing.push_back(index);
+								}
+							}
+							result = result.insert_n(position, passing.size(), [&](std::size_t index) {
+								return collection[passing[index - position]];
+							});
+							mask = std::make_shared<filter_mask_type>(
+								previous_mask.splice(first.index, 0, inserted));
+						} else {
+							result = result.erase(position,
+								previous_mask.count(first.index, first.index + first.count));
+							mask = std::make_shared<filter_mask_type>(
+								previous_mask.splice(first.index, first.count, {}));
+						}
+					}
+				} else {
+					mask = std::make_shared<filter_mask_type>();
+					std::vector<std::size_t> passing;
+					for (std::size_t index = 0; index < collection.size(); ++index) {
+						mask->push_back(passes(index));
+						if (mask->test(index)) {
+							passing.push_back(index);
+						}
+					}
+					result = container_type::generate(passing.size(), [&](std::size_t index) {
+						return collection[passing[index]];
 					});
 				}
-			}
+				callback(util::make_storage<commit_storage_type>(std::move(result),
+					util::default_revision, revisions, collection.version(), std::move(mask)));
+			});
 		}, std::forward<Dependencies>(dependencies)...);
 }
 
+} // namespace details
+
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto filter(Function &&function, Dependencies&&... dependencies) {
+	static_assert(I < sizeof...(Dependencies),
+		"expanded index must be in the range of [0, arity) where arity = number of dependencies.");
+	typedef typename util::unwrap_reference_t<std::tuple_element_t<I, std::tuple<Dependencies...>>>
+		::value_type argument_container_type;
+	typedef typename argument_container_type::value_type value_type;
+	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
+	static_assert(std::is_copy_constructible<value_type>::value, "T must be copy constructible.");
+	return details::filter<I, Comparator>(internal::is_diff_vector<argument_container_type>(),
+		std::forward<Function>(function), std::forward<Dependencies>(dependencies)...);
+}
+
 template<std::size_t I, typename Function, typename... Dependencies>
 auto filter(Function &&function, Dependencies&&... dependencies) {
 	typedef typename util::unwrap_reference_t<std::tuple_element_t<I, std::tuple<Dependencies...>>>
@@ -13,29 +13,40 @@
 #ifndef _FRP_STATIC_PUSH_MAP_H_
 #define _FRP_STATIC_PUSH_MAP_H_
 
+#include <frp/diff_vector.h>
 #include <frp/internal/namespace_alias.h>
 #include <frp/static/push/repository.h>
 #include <frp/util/collector.h>
 #include <frp/vector_view.h>
+#include <iterator>
 #include <vector>
 
 namespace frp {
 namespace stat {
 namespace push {
+namespace details {
 
-template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
-auto map(Function &&function, Dependencies... dependencies) {
-	static_assert(I < sizeof...(Dependencies),
-		"expanded index must be in the range of [0, arity) where arity = number of dependencies.");
-	static_assert(util::all_true_type<typename util::is_not_void<
-		typename util::unwrap_container_t<Dependencies>::value_type>::type...>::value,
-		"Dependencies can not be void type.");
+template<typename Container, std::size_t DependenciesN>
+struct map_diff_commit_storage_type : util::commit_storage_type<Container, DependenciesN> {
 
-	typedef util::map_return_t<I, Function, Dependencies...> value_type;
-	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
-	static_assert(std::is_move_constructible<value_type>::value, "T must be move constructible");
+	typedef util::commit_storage_type<Container, DependenciesN> parent_type;
+	typedef typename parent_type::revisions_type revisions_type;
+	typedef typename Container::version_type version_type;
+
+	// The version of the mapped vector this value was mapped from.
+	version_type input_version;
+
+	map_diff_commit_storage_type(Container &&value, util::revision_type revision,
+		const revisions_type &revisions, version_type input_version)
+		: parent_type(std::forward<Container>(value), revision, revisions)
+		, input_version(input_version) {}
+};
 
-	typedef vector_view_type<value_type, Comparator> collector_view_type;
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto map(std::false_type, Function &&function, Dependencies... dependencies) {
+	typedef util::map_return_t<I, Function, Dependencies...> value_type;
+	typedef internal::get_allocator_for_t<Function, value_type> allocator_type;
+	typedef vector_view_type<value_type, Comparator, allocator_type> collector_view_type;
 	typedef util::commit_storage_type<collector_view_type, sizeof...(Dependencies)>
 		commit_storage_type;
 	typedef std::array<util::revision_type, sizeof...(Dependencies)> revisions_type;
@@ -43,10 +54,12 @@ auto map(Function &&function, Dependencies... dependencies) {
 	return details::make_repository<collector_view_type, commit_storage_type,
 			std::equal_to<collector_view_type>>([
 				function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
-				executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+				executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function))),
+				allocator = allocator_type(internal::get_allocator(
+					util::unwrap_reference(std::forward<Function>(function))))](
 				auto &&callback, const auto &previous, const auto &dependencies) {
-		typedef util::fixed_size_collector_type<value_type, Comparator> collector_type;
-		typedef vector_view_type<value_type, Comparator> collector_view_type;
+		typedef util::fixed_size_collector_type<value_type, Comparator, allocator_type>
+			collector_type;
 
 		auto values(util::invoke([&](const auto&... dependency) {
 			return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
@@ -56,50 +69,136 @@ auto map(Function &&function, Dependencies... dependencies) {
 		}, values));
 		auto &collection(std::get<I>(values)->value);
 		if (collection.empty()) {
-			callback(std::make_shared<commit_storage_type>(
-				collector_view_type(collector_type(0)), util::default_revision,
-				revisions));
+			callback(util::make_storage<commit_storage_type>(
+				collector_view_type(collector_type(0, allocator_type(allocator))),
+				util::default_revision, revisions));
 		} else {
-			auto collector(std::make_shared<collector_type>(collection.size()));
-			std::size_t counter(0);
-			for (const auto &value : collection) {
-				std::size_t index(counter++);
-				executor([function, collector, index, &value, callback, values, revisions]() {
-					auto complete(collector->construct(index,
-						util::indexed_invoke_with_replacement<I>(std::move(function),
-							std::cref(value),
-							util::invoke([&](const auto&... values) {
-								return std::tie(values->value...);
-							}, values))));
-					if (complete) {
-						callback(std::make_shared<commit_storage_type>(
-							collector_view_type(std::move(*collector)),
-							util::default_revision, revisions));
+			auto collector(std::allocate_shared<collector_type>(allocator, collection.size(),
+				allocator_type(allocator)));
+			internal::for_range(executor, collection.size(), [function, collector, &collection,
+					callback, values, revisions](std::size_t begin, std::size_t end) {
+				auto arguments(util::invoke([&](const auto&... values) {
+					return std::tie(values->value...);
+				}, values));
+				auto it(std::next(std::begin(collection), begin));
+				for (auto index = begin; index < end; ++index, ++it) {
+					collector->emplace(index, util::indexed_invoke_with_replacement<I>(function,
+						std::cref(*it), arguments));
+				}
+				if (collector->complete(end - begin)) {
+					callback(util::make_storage<commit_storage_type>(
+						collector_view_type(std::move(*collector)),
+						util::default_revision, revisions));
+				}
+			});
+		}
+	}, std::forward<Dependencies>(dependencies)...);
+}
+
+// Maps a diff_vector_type into another one. When the other dependencies did not
+// change, only the values changed since the last mapped version are mapped
+// again; the rest is shared with the previous result.
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto map(std::true_type, Function &&function, Dependencies... dependencies) {
+	typedef util::map_return_t<I, Function, Dependencies...> value_type;
+	typedef diff_vector_type<value_type, Comparator> container_type;
+	typedef map_diff_commit_storage_type<container_type, sizeof...(Dependencies)>
+		commit_storage_type;
+	typedef typename commit_storage_type::revisions_type revisions_type;
+
+	return details::make_repository<container_type, commit_storage_type,
+			std::equal_to<container_type>>([
+				function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
+				executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+				auto &&callback, const auto &previous_storage, const auto &dependencies) {
+		executor([=, callback = std::move(callback)]() {
+			auto values(util::invoke([&](const auto&... dependency) {
+				return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
+			}, *dependencies));
+			auto revisions(util::invoke([&](const auto&... storage) {
+				return revisions_type{ storage->revision... };
+			}, values));
+			auto previous(previous_storage->load());
+			if (previous && !previous->is_newer(revisions)) {
+				return;
+			}
+
+			auto &collection(std::get<I>(values)->value);
+			auto arguments(util::invoke([&](const auto&... storage) {
+				return std::tie(storage->value...);
+			}, values));
+			auto evaluate([&](std::size_t index) {
+				return util::indexed_invoke_with_replacement<I>(function,
+					std::cref(collection[index]), arguments);
+			});
+
+			std::vector<diff_type> changes;
+			container_type result;
+			if (previous && util::tuple_le_except_index<I>(revisions, previous->revisions)
+				&& collection.changes_since(previous->input_version, changes)
+				&& internal::replayable(changes)) {
+				result = previous->value;
+				for (const auto &change : changes) {
+					switch (change.kind) {
+					case diff_type::update:
+						result = result.update_n(change.index, change.count, evaluate);
+						break;
+					case diff_type::insert:
+						result = result.insert_n(change.index, change.count, evaluate);
+						break;
+					case diff_type::erase:
+						result = result.erase(change.index, change.count);
+						break;
 					}
-				});
+				}
+			} else {
+				result = container_type::generate(collection.size(), evaluate);
 			}
-		}
+			callback(util::make_storage<commit_storage_type>(std::move(result),
+				util::default_revision, revisions, collection.version()));
+		});
 	}, std::forward<Dependencies>(dependencies)...);
 }
 
+} // namespace details
+
+template<std::size_t I, typename Comparator, typename Function, typename... Dependencies>
+auto map(Function &&function, Dependencies... dependencies) {
+	static_assert(I < sizeof...(Dependencies),
+		"expanded index must be in the range of [0, arity) where arity = number of dependencies.");
+	static_assert(util::all_true_type<typename util::is_not_void<
+		typename util::unwrap_container_t<Dependencies>::value_type>::type...>::value,
+		"Dependencies can not be void type.");
+
+	typedef util::map_return_t<I, Function, Dependencies...> value_type;
+	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
+	static_assert(std::is_move_constructible<value_type>::value, "T must be move constructible");
+
+	typedef typename util::unwrap_container_t<std::tuple_element_t<I, std::tuple<Dependencies...>>>
+		::value_type argument_container_type;
+	return details::map<I, Comparator>(internal::is_diff_vector<argument_container_type>(),
+		std::forward<Function>(function), std::forward<Dependencies>(dependencies)...);
+}
+
 template<std::size_t I, typename Function, typename... Dependencies>
 auto map(Function &&function, Dependencies... dependencies) {
 	typedef util::map_return_t<I, Function, Dependencies...> value_type;
 	static_assert(util::is_equality_comparable<value_type>::value,
 		"T must implement equality comparator");
-	return map<I, std::equal_to<value_type>>(std::forward<Function>(function),
+	return push::map<I, std::equal_to<value_type>>(std::forward<Function>(function),
 		std::forward<Dependencies>(dependencies)...);
 }
 
 template<typename Comparator, typename Function, typename... Dependencies>
 auto map(Function &&function, Dependencies... dependencies) {
-	return map<0, Comparator>(std::forward<Function>(function),
+	return push::map<0, Comparator>(std::forward<Function>(function),
 		std::forward<Dependencies>(dependencies)...);
 }
 
 template<typename Function, typename... Dependencies>
 auto map(Function &&function, Dependencies... dependencies) {
-	return map<0>(std::forward<Function>(function), std::forward<Dependencies>(dependencies)...);
+	return push::map<0>(std::forward<Function>(function),
+		std::forward<Dependencies>(dependencies)...);
 }
 
 } // namespace push
@@ -16,8 +16,10 @@
 #include <frp/internal/namespace_alias.h>
 #include <frp/static/push/repository.h>
 #include <frp/util/collector.h>
+#include <frp/util/flat_cache.h>
 #include <frp/vector_view.h>
-#include <unordered_map>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 namespace frp {
@@ -25,17 +27,32 @@ namespace stat {
 namespace push {
 namespace details {
 
-template<typename K, typename V, typename Container, typename Hash, std::size_t DependenciesN>
+template<typename K, typename V, typename Container, typename Input, typename Hash,
+	std::size_t DependenciesN>
 struct map_cache_commit_storage_type : util::commit_storage_type<Container, DependenciesN> {
 
-	typedef std::unordered_map<K, std::reference_wrapper<const V>, Hash> cache_type;
+	typedef util::flat_cache_type<K, V, Hash> cache_type;
+	typedef util::buffer_recycler_type<typename cache_type::buffer_type> recycler_type;
 	typedef frp::util::commit_storage_type<Container, DependenciesN> parent_type;
 	typedef typename parent_type::revisions_type revisions_type;
+
+	// The cache points into input, the mapped collection, and into value.
+	Input input;
+	std::shared_ptr<recycler_type> recycler;
 	cache_type cache;
 
 	map_cache_commit_storage_type(Container &&value, util::revision_type revision,
-		const revisions_type &revisions) : util::commit_storage_type<Container, DependenciesN>(
-			std::forward<Container>(value), revision, revisions) {}
+		const revisions_type &revisions, const Input &input,
+		const std::shared_ptr<recycler_type> &recycler)
+		: util::commit_storage_type<Container, DependenciesN>(
+			std::forward<Container>(value), revision, revisions)
+		, input(input)
+		, recycler(recycler)
+		, cache(recycler->take()) {}
+
+	~map_cache_commit_storage_type() {
+		recycler->give(cache.release());
+	}
 };
 
 } // namespace details
@@ -56,19 +73,25 @@ auto map_cache(Function &&function, Dependencies... dependencies) {
 		"T must be move constructible");
 	static_assert(!std::is_void<value_type>::value, "T must not be void type.");
 
-	typedef vector_view_type<value_type, Comparator> collector_view_type;
+	typedef internal::get_allocator_for_t<Function, value_type> allocator_type;
+	typedef vector_view_type<value_type, Comparator, allocator_type> collector_view_type;
+	typedef decltype(internal::get_storage(util::unwrap_container(std::declval<
+		std::tuple_element_t<I, std::tuple<Dependencies...>> &>()))) input_type;
 	typedef details::map_cache_commit_storage_type<argument_type, value_type, collector_view_type,
-		Hash, sizeof...(Dependencies)> commit_storage_type;
+		input_type, Hash, sizeof...(Dependencies)> commit_storage_type;
 	typedef std::array<util::revision_type, sizeof...(Dependencies)> revisions_type;
 	return details::make_repository<collector_view_type, commit_storage_type,
 			std::equal_to<collector_view_type>>([
 				function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
-				executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+				executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function))),
+				allocator = allocator_type(internal::get_allocator(
+					util::unwrap_reference(std::forward<Function>(function)))),
+				recycler = std::make_shared<typename commit_storage_type::recycler_type>()](
 				auto &&callback, const auto &previous_storage, const auto &dependencies) {
-		typedef util::fixed_size_collector_type<value_type, Comparator> collector_type;
-		typedef vector_view_type<value_type, Comparator> collector_view_type;
+		typedef util::fixed_size_collector_type<value_type, Comparator, allocator_type>
+			collector_type;
 
-		auto previous(std::atomic_load(&*previous_storage));
+		auto previous(previous_storage->load());
 		auto values(util::invoke([&](const auto&... dependency) {
 			return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
 		}, *dependencies));
@@ -78,40 +101,50 @@ auto map_cache(Function &&function, Dependencies... dependencies) {
 			}, values));
 		auto &collection(std::get<I>(values)->value);
 		if (collection.empty()) {
-			callback(std::make_shared<commit_storage_type>(
-				collector_view_type(collector_type(0)), util::default_revision,
-				revisions));
+			callback(util::make_storage<commit_storage_type>(
+				collector_view_type(collector_type(0, allocator_type(allocator))),
+				util::default_revision, revisions, std::get<I>(values), recycler));
 		} else {
-			auto collector(std::make_shared<collector_type>(collection.size()));
-			std::size_t counter(0);
+			auto collector(std::allocate_shared<collector_type>(allocator, collection.size(),
+				allocator_type(allocator)));
 			bool cache_usable(previous && frp::util::tuple_le_except_index<I>(
 				revisions, previous->revisions));
-			for (const auto &value : collection) {
-				std::size_t index(counter++);
-				executor([function, collector, index, &value, callback, previous, revisions,
-					cache_usable, values]() {
-					auto &collection(std::get<I>(values)->value);
-					typename commit_storage_type::cache_type::iterator it;
-					if (cache_usable && (it = previous->cache.find(value))
-						!= previous->cache.end() ? collector->construct(index, it->second)
-						: collector->construct(index,
-							util::indexed_invoke_with_replacement<I>(std::move(function),
-								std::cref(value), util::invoke([&](const auto&... storage) {
-									return std::tie(storage->value...);
-								}, values)))) {
-						auto commit(std::make_shared<commit_storage_type>(
-							collector_view_type(std::move(*collector)),
-							util::default_revision, revisions));
-						std::transform(std::begin(collection), std::end(collection),
-							std::begin(commit->value),
-							std::inserter(commit->cache, std::end(commit->cache)),
-							[](auto &key, auto &value) {
-								return std::make_pair(key, std::ref(value));
-							});
-						callback(commit);
+			internal::for_range(executor, collection.size(), [function, collector, &collection,
+					callback, previous, revisions, cache_usable, values, recycler](
+					std::size_t begin, std::size_t end) {
+				auto arguments(util::invoke([&](const auto&... storage) {
+					return std::tie(storage->value...);
+				}, values));
+				auto it(std::next(std::begin(collection), begin));
+				// Most values sit where they were in the previous collection, so
+				// the same position is tried before the cache.
+				bool aligned(cache_usable && previous->input->value.size() == collection.size());
+				decltype(std::begin(previous->input->value)) previous_it{};
+				if (aligned) {
+					previous_it = std::next(std::begin(previous->input->value), begin);
+				}
+				for (auto index = begin; index < end; ++index, ++it) {
+					const value_type *cached(nullptr);
+					if (aligned && *previous_it++ == *it) {
+						cached = &previous->value[index];
+					} else if (cache_usable) {
+						cached = previous->cache.find(*it);
+					}
+					if (cached) {
+						collector->emplace(index, *cached);
+					} else {
+						collector->emplace(index, util::indexed_invoke_with_replacement<I>(
+							function, std::cref(*it), arguments));
 					}
-				});
-			}
+				}
+				if (collector->complete(end - begin)) {
+					auto commit(util::make_storage<commit_storage_type>(
+						collector_view_type(std::move(*collector)),
+						util::default_revision, revisions, std::get<I>(values), recycler));
+					commit->cache.assign(collection, commit->value);
+					callback(commit);
+				}
+			});
 		}
 	}, std::forward<Dependencies>(dependencies)...);
 }
@@ -19,10 +19,12 @@
 #include <frp/util/function.h>
 #include <frp/util/observable.h>
 #include <frp/util/observe_all.h>
+#include <frp/util/propagation.h>
 #include <frp/util/reference.h>
 #include <frp/util/storage.h>
 #include <frp/util/variadic.h>
 #include <frp/util/vector.h>
+#include <algorithm>
 
 namespace frp {
 namespace stat {
@@ -34,23 +36,23 @@ struct repository_type;
 namespace details {
 
 template<typename Storage, typename Comparator>
-void submit_commit(const std::shared_ptr<std::shared_ptr<Storage>> &storage,
+void submit_commit(const std::shared_ptr<util::atomic_storage_ptr<Storage>> &storage,
 		const std::shared_ptr<util::observable_type> &observable,
-		const Comparator &comparator, const std::shared_ptr<Storage> &current) {
-	auto value(std::atomic_load(&*storage));
+		const Comparator &comparator, const util::storage_ptr<Storage> &current) {
+	auto value(storage->load());
 	bool exchanged(false), equals;
 	do {
 		current->revision = (value ? value->revision : util::default_revision) + 1;
 		equals = value && current->compare_value(*value, comparator);
 	} while ((!value || value->is_newer(current->revisions))
-		&& !(exchanged = std::atomic_compare_exchange_strong(&*storage, &value, current)));
+		&& !(exchanged = storage->compare_exchange(value, current)));
 	if (exchanged && !equals) {
 		observable->update();
 	}
 }
 
 template<typename Storage, typename Generator, typename Comparator, typename... Dependencies>
-void attempt_commit_callback(const std::shared_ptr<std::shared_ptr<Storage>> &storage,
+void attempt_commit_callback(const std::shared_ptr<util::atomic_storage_ptr<Storage>> &storage,
 		const std::shared_ptr<Generator> &generator, Comparator &comparator,
 		const std::shared_ptr<util::observable_type> &observable,
 		const std::shared_ptr<std::tuple<Dependencies...>> &dependencies) {
@@ -81,6 +83,8 @@ struct repository_type {
 		->decltype(observable.add_callback(std::forward<F>(f)));
 	template<typename U>
 	friend auto internal::get_storage(U &value)->decltype(value.get_storage());
+	template<typename U>
+	friend auto internal::get_depth(U &value)->decltype(value.get_depth());
 
 	typedef T value_type;
 
@@ -89,24 +93,31 @@ struct repository_type {
 private:
 	template<typename Update, typename Provider, typename... Dependencies>
 	repository_type(const std::shared_ptr<util::observable_type> &observable, const Update &update,
-		Provider &&provider, const std::shared_ptr<std::tuple<Dependencies...>> &dependencies)
+		Provider &&provider, const std::shared_ptr<std::tuple<Dependencies...>> &dependencies,
+		std::size_t depth)
 		: observable(observable)
 		, callbacks(util::vector_from_array(util::invoke(
 			util::observe_all(update), std::ref(*dependencies))))
-		, provider(std::forward<Provider>(provider)) {}
+		, provider(std::forward<Provider>(provider))
+		, depth(depth) {}
 
 	auto get_storage() const {
 		return provider();
 	}
 
+	std::size_t get_depth() const {
+		return depth;
+	}
+
 	template<typename F>
 	auto add_callback(F &&f) const {
 		return observable->add_callback(std::forward<F>(f));
 	}
 
-	std::function<std::shared_ptr<util::storage_type<T>>()> provider;
+	std::function<util::storage_ptr<util::storage_type<T>>()> provider;
 	std::shared_ptr<util::observable_type> observable;
 	std::vector<util::observable_type::reference_type> callbacks;
+	std::size_t depth = 0;
 };
 
 namespace details {
@@ -116,7 +127,7 @@ template<typename T, typename Storage, typename Comparator, typename Generator,
 repository_type<T> make_repository(Generator &&generator, Dependencies &&... dependencies) {
 	// TODO(gardell): Group storage together, there's an awful lot of shared_ptr instances!
 	// Note that storage should be kept separate, since its highly volatile.
-	auto storage(std::make_shared<std::shared_ptr<Storage>>());
+	auto storage(std::make_shared<util::atomic_storage_ptr<Storage>>());
 	auto observable(std::make_shared<util::observable_type>());
 	auto shared_dependencies(std::make_shared<std::tuple<Dependencies...>>(
 		std::forward<Dependencies>(dependencies)...));
@@ -124,8 +135,18 @@ repository_type<T> make_repository(Generator &&generator, Dependencies &&... dep
 		&attempt_commit_callback<Storage, Generator, Comparator, Dependencies...>,
 		storage, std::make_shared<Generator>(std::forward<Generator>(generator)), Comparator(),
 		observable, shared_dependencies));
-	auto provider([=]() { return std::atomic_load(&*storage); });
-	repository_type<T> repository(observable, callback, provider, shared_dependencies);
+	auto provider([=]() { return util::storage_ptr<util::storage_type<T>>(storage->load()); });
+	// Dependencies notify through the propagation, which evaluates this repository once,
+	// after all of them.
+	auto depth(1 + util::invoke([](const auto&... dependencies) {
+		return std::max({ std::size_t(0),
+			internal::get_depth(util::unwrap_container(dependencies))... });
+	}, *shared_dependencies));
+	auto update([depth, order = util::propagation_type::next_order(),
+			evaluate = std::make_shared<const std::function<void()>>(callback)]() {
+		util::propagation_type::schedule(depth, order, evaluate);
+	});
+	repository_type<T> repository(observable, update, provider, shared_dependencies, depth);
 	callback();
 	return repository;
 }
@@ -63,14 +63,63 @@ struct sink_type {
 			return operator*();
 		}
 
+		// The value, or nullptr if none is available yet.
+		const T *get() const {
+			return value ? &value->value : nullptr;
+		}
+
 	private:
-		explicit reference(std::shared_ptr<util::storage_type<T>> &&value)
-			: value(std::forward<std::shared_ptr<util::storage_type<T>>>(value)) {}
-		std::shared_ptr<util::storage_type<T>> value;
+		explicit reference(util::storage_ptr<util::storage_type<T>> &&value)
+			: value(std::forward<util::storage_ptr<util::storage_type<T>>>(value)) {}
+		util::storage_ptr<util::storage_type<T>> value;
+	};
+
+	// Reads the latest value of a sink from one thread, only adding a reference
+	// when the value changed since the last read. A snapshot must not be
+	// shared between threads, and values returned by get() are valid until its
+	// next call. It keeps reading the last value once the sink is destroyed.
+	struct snapshot_type {
+		template<typename U>
+		friend struct sink_type;
+
+		typedef T value_type;
+
+		// The latest value, or nullptr if none is available yet.
+		const T *get() {
+			if (source->peek() != cached.get()) {
+				cached = source->load();
+			}
+			return cached ? &cached->value : nullptr;
+		}
+
+		const T &operator*() {
+			auto value(get());
+			if (!value) {
+				throw std::domain_error("value not available");
+			}
+			return *value;
+		}
+
+		const T *operator->() {
+			return &operator*();
+		}
+
+	private:
+		typedef util::atomic_storage_ptr<util::storage_type<T>> source_type;
+
+		explicit snapshot_type(const std::shared_ptr<const source_type> &source)
+			: source(source) {}
+
+		std::shared_ptr<const source_type> source;
+		util::storage_ptr<util::storage_type<T>> cached;
 	};
 
 	reference operator*() const {
-		return reference(provider());
+		return reference(value->load());
+	}
+
+	snapshot_type snapshot() const {
+		return snapshot_type(value);
 	}
 
 private:
@@ -80,16 +129,11 @@ private:
 		explicit template_storage_type(Dependency &&dependency)
 			: dependency(std::forward<Dependency>(dependency)) {}
 
-		std::shared_ptr<util::storage_type<T>> get() const {
-			return std::atomic_load(&value);
-		}
-
 		void evaluate() {
-			std::atomic_store(&value,
-				internal::get_storage(util::unwrap_container(dependency)));
+			value.store(internal::get_storage(util::unwrap_container(dependency)));
 		}
 
-		std::shared_ptr<util::storage_type<T>> value; // Use atomics!
+		util::atomic_storage_ptr<util::storage_type<T>> value;
 		Dependency dependency;
 	};
 
@@ -101,7 +145,7 @@ private:
 
 	template<typename Storage>
 	explicit sink_type(const std::shared_ptr<Storage> &storage)
-		: provider([=]() { return storage->get(); })
+		: value(storage, &storage->value)
 		, callback(util::add_callback(util::unwrap_reference(storage->dependency),
 			[weak_storage = std::weak_ptr<Storage>(storage)]() {
 				auto s(weak_storage.lock());
@@ -112,7 +156,7 @@ private:
 		storage->evaluate();
 	}
 
-	std::function<std::shared_ptr<util::storage_type<T>>()> provider;
+	std::shared_ptr<const util::atomic_storage_ptr<util::storage_type<T>>> value;
 	util::observable_type::reference_type callback;
 };
 
@@ -17,8 +17,11 @@
 #include <frp/internal/operator.h>
 #include <frp/util/observable.h>
 #include <frp/util/storage.h>
+#include <frp/util/uncaught_exceptions.h>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace frp {
 namespace stat {
@@ -70,6 +73,8 @@ struct source_type {
 		->decltype(observable.add_callback(std::forward<F>(f)));
 	template<typename U>
 	friend auto internal::get_storage(U &value)->decltype(value.get_storage());
+	template<typename U>
+	friend auto internal::get_depth(U &value)->decltype(value.get_depth());
 
 	typedef T value_type;
 
@@ -97,36 +102,36 @@ private:
 		: storage(std::forward<std::unique_ptr<StorageT>>(storage)) {}
 
 	struct storage_type : util::observable_type {
-		virtual void accept(std::shared_ptr<util::storage_type<T>> &&) = 0;
-		virtual std::shared_ptr<util::storage_type<T>> get() const = 0;
+		virtual void accept(util::storage_ptr<util::storage_type<T>> &&) = 0;
+		virtual util::storage_ptr<util::storage_type<T>> get() const = 0;
 		virtual ~storage_type() {}
 	};
 
 	template<typename Comparator>
 	struct template_storage_type : storage_type {
 		template_storage_type() = default;
-		explicit template_storage_type(T &&value) : value(std::make_shared<util::storage_type<T>>(
+		explicit template_storage_type(T &&value) : value(util::make_storage<util::storage_type<T>>(
 			std::forward<T>(value), util::default_revision)) {}
 		explicit template_storage_type(const T &value)
-			: value(std::make_shared<util::storage_type<T>>(value, util::default_revision)) {}
+			: value(util::make_storage<util::storage_type<T>>(value, util::default_revision)) {}
 
-		std::shared_ptr<util::storage_type<T>> get() const override final {
-			return std::atomic_load(&value);
+		util::storage_ptr<util::storage_type<T>> get() const override final {
+			return value.load();
 		}
 
-		void accept(std::shared_ptr<util::storage_type<T>> &&replacement) override final {
+		void accept(util::storage_ptr<util::storage_type<T>> &&replacement) override final {
 			bool changed(false);
 			auto current = get();
 			do {
 				replacement->revision = (current ? current->revision : util::default_revision) + 1;
 			} while ((!current || !current->compare_value(*replacement, comparator))
-				&& !(changed = std::atomic_compare_exchange_weak(&value, &current, replacement)));
+				&& !(changed = value.compare_exchange(current, replacement)));
 			if (changed) {
 				util::observable_type::update();
 			}
 		}
 
-		std::shared_ptr<util::storage_type<T>> value; // Use atomics!
+		util::atomic_storage_ptr<util::storage_type<T>> value;
 		Comparator comparator;
 	};
 
@@ -134,6 +139,10 @@ private:
 		return storage->get();
 	}
 
+	std::size_t get_depth() const {
+		return 0;
+	}
+
 	template<typename F>
 	auto add_callback(F &&f) const {
 		return storage->add_callback(std::forward<F>(f));
@@ -170,25 +179,137 @@ public:
 			return operator*();
 		}
 
+		// The value, or nullptr if none is available yet.
+		const T *get() const {
+			return value ? &value->value : nullptr;
+		}
+
 	private:
-		explicit reference(std::shared_ptr<util::storage_type<T>> &&value)
-			: value(std::forward<std::shared_ptr<util::storage_type<T>>>(value)) {}
-		std::shared_ptr<util::storage_type<T>> value;
+		explicit reference(util::storage_ptr<util::storage_type<T>> &&value)
+			: value(std::forward<util::storage_ptr<util::storage_type<T>>>(value)) {}
+		util::storage_ptr<util::storage_type<T>> value;
+	};
+
+	// Writes to a source that are published together, once, when the batch
+	// commits or goes out of scope; only the last value written is published.
+	// A batch destroyed while an exception unwinds the stack drops its value
+	// instead. The destructor ignores the exceptions a dependent may throw
+	// while publishing; call commit() to get them.
+	struct batch_type {
+
+		template<typename U>
+		friend struct source_type;
+
+		batch_type(batch_type &&) = default;
+		batch_type &operator=(batch_type &&) = delete;
+
+		~batch_type() {
+			if (util::uncaught_exceptions() > uncaught) {
+				pending = nullptr;
+				return;
+			}
+			try {
+				commit();
+			}
+			catch (...) {
+			}
+		}
+
+		auto &operator=(T &&value) {
+			store(std::forward<T>(value), std::is_assignable<T &, T &&>());
+			return *this;
+		}
+
+		auto &operator=(const T &value) {
+			store(value, std::is_assignable<T &, const T &>());
+			return *this;
+		}
+
+		// The value is taken before it is published, so the batch is empty
+		// even if a dependent throws.
+		void commit() {
+			if (pending) {
+				auto value(std::move(pending));
+				storage.accept(std::move(value));
+			}
+		}
+
+	private:
+		explicit batch_type(storage_type &storage) : storage(storage) {}
+
+		// The pending value is not published yet, so it is overwritten in place.
+		template<typename U>
+		void store(U &&value, std::true_type) {
+			if (pending) {
+				pending->value = std::forward<U>(value);
+			}
+			else {
+				store(std::forward<U>(value), std::false_type());
+			}
+		}
+
+		template<typename U>
+		void store(U &&value, std::false_type) {
+			pending = util::make_storage<util::storage_type<T>>(std::forward<U>(value));
+		}
+
+		storage_type &storage;
+		util::storage_ptr<util::storage_type<T>> pending;
+		int uncaught = util::uncaught_exceptions();
 	};
 
 	auto &operator=(T &&value) const {
-		storage->accept(std::make_shared<util::storage_type<T>>(std::forward<T>(value)));
+		storage->accept(util::make_storage<util::storage_type<T>>(std::forward<T>(value)));
 		return *this;
 	}
 
 	auto &operator=(const T &value) const {
-		storage->accept(std::make_shared<util::storage_type<T>>(value));
+		storage->accept(util::make_storage<util::storage_type<T>>(value));
+		return *this;
+	}
+
+	batch_type batch() const {
+		return batch_type(*storage);
+	}
+
+	// Publishes the last of a range of values in one revision, as a batch
+	// writing each of them in turn would.
+	template<typename ForwardIterator>
+	auto &submit_many(ForwardIterator first, ForwardIterator last) const {
+		if (first != last) {
+			storage->accept(util::make_storage<util::storage_type<T>>(*last_of(first, last,
+				typename std::iterator_traits<ForwardIterator>::iterator_category())));
+		}
 		return *this;
 	}
 
 	reference operator*() const {
 		return reference(get_storage());
 	}
+
+private:
+	// The last iterator of a non-empty range.
+	template<typename ForwardIterator>
+	static ForwardIterator last_of(ForwardIterator first, ForwardIterator last,
+			std::forward_iterator_tag) {
+		auto final(first);
+		while (++first != last) {
+			final = first;
+		}
+		return final;
+	}
+
+	template<typename BidirectionalIterator>
+	static BidirectionalIterator last_of(BidirectionalIterator, BidirectionalIterator last,
+			std::bidirectional_iterator_tag) {
+		return std::prev(last);
+	}
+
+	template<typename RandomAccessIterator>
+	static RandomAccessIterator last_of(RandomAccessIterator first, RandomAccessIterator last,
+			std::random_access_iterator_tag) {
+		return std::next(first, std::distance(first, last) - 1);
+	}
 };
 
 template<typename Comparator, typename T>
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_STATIC_PUSH_STREAM_SOURCE_H_
+#define _FRP_STATIC_PUSH_STREAM_SOURCE_H_
+
+#include <frp/internal/namespace_alias.h>
+#include <frp/internal/operator.h>
+#include <frp/static/push/source.h>
+#include <frp/util/collector.h>
+#include <frp/util/uncaught_exceptions.h>
+#include <frp/vector_view.h>
+#include <iterator>
+#include <vector>
+
+namespace frp {
+namespace stat {
+namespace push {
+namespace details {
+
+// Batches are separate events even when they hold equal values.
+template<typename T>
+struct never_equal_type {
+	bool operator()(const T &, const T &) const {
+		return false;
+	}
+};
+
+} // namespace details
+
+// A source of batches of values. Every batch is published as one
+// vector_view_type in one revision, so dependents are evaluated once per batch
+// and see all of its values, not only the last.
+template<typename T, typename Comparator = std::equal_to<T>>
+struct stream_source_type {
+
+	template<typename U, typename Comparator_>
+	friend stream_source_type<U, Comparator_> stream_source();
+	template<typename O, typename F>
+	friend auto util::add_callback(O &observable, F &&f)
+		->decltype(observable.add_callback(std::forward<F>(f)));
+	template<typename U>
+	friend auto internal::get_storage(U &value)->decltype(value.get_storage());
+	template<typename U>
+	friend auto internal::get_depth(U &value)->decltype(value.get_depth());
+
+	typedef vector_view_type<T, Comparator> value_type;
+
+	static_assert(std::is_copy_constructible<T>::value, "T must be copy constructible.");
+
+	// Values appended to a stream, published when the batch commits or goes
+	// out of scope. Like source_type::batch_type, a batch destroyed while an
+	// exception unwinds the stack drops its values, and the destructor ignores
+	// the exceptions a dependent may throw while publishing.
+	struct batch_type {
+
+		template<typename U, typename Comparator_>
+		friend struct stream_source_type;
+
+		batch_type(batch_type &&) = default;
+		batch_type &operator=(batch_type &&) = delete;
+
+		~batch_type() {
+			if (util::uncaught_exceptions() > uncaught) {
+				pending.clear();
+				return;
+			}
+			try {
+				commit();
+			}
+			catch (...) {
+			}
+		}
+
+		void push_back(const T &value) {
+			pending.push_back(value);
+		}
+
+		void push_back(T &&value) {
+			pending.push_back(std::move(value));
+		}
+
+		void commit() {
+			if (!pending.empty()) {
+				auto values(std::move(pending));
+				pending.clear();
+				stream.submit_many(std::make_move_iterator(values.begin()),
+					std::make_move_iterator(values.end()));
+			}
+		}
+
+	private:
+		explicit batch_type(const stream_source_type &stream) : stream(stream) {}
+
+		const stream_source_type &stream;
+		std::vector<T> pending;
+		int uncaught = util::uncaught_exceptions();
+	};
+
+	batch_type batch() const {
+		return batch_type(*this);
+	}
+
+	// Publishes a range of values as one batch.
+	template<typename ForwardIterator>
+	auto &submit_many(ForwardIterator first, ForwardIterator last) const {
+		std::size_t size(std::distance(first, last));
+		if (size > 0) {
+			util::fixed_size_collector_type<T, Comparator> collector(size);
+			for (std::size_t index = 0; first != last; ++first, ++index) {
+				collector.emplace(index, *first);
+			}
+			collector.complete(size);
+			source = value_type(std::move(collector));
+		}
+		return *this;
+	}
+
+	auto operator*() const {
+		return *source;
+	}
+
+private:
+	explicit stream_source_type(source_type<value_type> &&source) : source(std::move(source)) {}
+
+	auto get_storage() const {
+		return internal::get_storage(source);
+	}
+
+	std::size_t get_depth() const {
+		return 0;
+	}
+
+	template<typename F>
+	auto add_callback(F &&f) const {
+		return util::add_callback(source, std::forward<F>(f));
+	}
+
+	source_type<value_type> source;
+};
+
+template<typename T, typename Comparator = std::equal_to<T>>
+stream_source_type<T, Comparator> stream_source() {
+	typedef typename stream_source_type<T, Comparator>::value_type value_type;
+	return stream_source_type<T, Comparator>(
+		source<details::never_equal_type<value_type>, value_type>());
+}
+
+} // namespace push
+} // namespace stat
+} // namespace frp
+
+#endif // _FRP_STATIC_PUSH_STREAM_SOURCE_H_
@@ -41,7 +41,7 @@ auto transform(Function &&function, Dependencies... dependencies) {
 			auto revisions(util::invoke([&](const auto&... storage) {
 				return revisions_type{ storage->revision... };
 			}, current));
-			auto last(std::atomic_load(&*previous));
+			auto last(previous->load());
 			if (!last || last->is_newer(revisions)) {
 				callback(util::invoke([&](const auto&... storage) {
 					revisions_type revisions{ storage->revision... };
@@ -56,7 +56,7 @@ auto transform(Function &&function, Dependencies... dependencies) {
 template<typename Function, typename... Dependencies>
 auto transform(Function &&function, Dependencies... dependencies) {
 	typedef util::transform_return_type<Function, Dependencies...> value_type;
-	return transform<std::equal_to<value_type>, Function, Dependencies...>(
+	return push::transform<std::equal_to<value_type>, Function, Dependencies...>(
 		std::forward<Function>(function), std::forward<Dependencies>(dependencies)...);
 }
 
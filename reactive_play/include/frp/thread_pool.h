@@ -0,0 +1,189 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_THREAD_POOL_H_
+#define _FRP_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace frp {
+
+// Work-stealing executor.
+//
+// Every thread has its own queue. Tasks submitted from a pool thread go to the
+// back of its queue and it runs them newest first; idle threads steal the
+// oldest task from the other queues. for_range splits a range of indices into
+// one chunk per task, which map and filter use instead of one task per
+// element.
+//
+// Pass it by reference, frp::execute_on(std::ref(pool), function), since the
+// pool can not be copied. The destructor runs all queued tasks, then stops the
+// threads.
+struct thread_pool_type {
+
+	// chunk_size is the number of indices per task in for_range; 0 splits a
+	// range into four chunks per thread.
+	explicit thread_pool_type(std::size_t thread_count = std::thread::hardware_concurrency(),
+			std::size_t chunk_size = 0)
+		: queues(std::max<std::size_t>(thread_count, 1)), chunk_size(chunk_size) {
+		threads.reserve(queues.size());
+		for (std::size_t index = 0; index < queues.size(); ++index) {
+			threads.emplace_back([this, index]() { work(index); });
+		}
+	}
+
+	thread_pool_type(const thread_pool_type &) = delete;
+	thread_pool_type &operator=(const thread_pool_type &) = delete;
+
+	~thread_pool_type() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		ready.notify_all();
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	template<typename F>
+	void operator()(F &&f) {
+		submit(std::function<void()>(std::forward<F>(f)));
+	}
+
+	// Calls f(begin, end) for consecutive chunks covering [0, count).
+	template<typename F>
+	void for_range(std::size_t count, F &&f) {
+		auto size(chunk_size ? chunk_size
+			: std::max<std::size_t>(1, (count + 4 * queues.size() - 1) / (4 * queues.size())));
+		auto shared(std::make_shared<std::decay_t<F>>(std::forward<F>(f)));
+		for (std::size_t begin = 0; begin < count; begin += size) {
+			auto end(std::min(count, begin + size));
+			submit([shared, begin, end]() { (*shared)(begin, end); });
+		}
+	}
+
+	std::size_t concurrency() const {
+		return threads.size();
+	}
+
+private:
+	typedef std::function<void()> task_type;
+
+	struct queue_type {
+		std::mutex mutex;
+		std::deque<task_type> tasks;
+	};
+
+	struct worker_type {
+		thread_pool_type *pool;
+		std::size_t index;
+	};
+
+	static worker_type &current_worker() {
+		thread_local worker_type worker{ nullptr, 0 };
+		return worker;
+	}
+
+	// pending is raised after the push, so a thread that sees it raised finds
+	// the task. It can briefly drop below zero when a task is taken before it
+	// is counted. The pool-wide mutex is only taken to wake a sleeping thread.
+	void submit(task_type &&task) {
+		auto &worker(current_worker());
+		auto index(worker.pool == this ? worker.index
+			: next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+		{
+			std::lock_guard<std::mutex> queue_lock(queues[index].mutex);
+			queues[index].tasks.push_back(std::move(task));
+		}
+		pending.fetch_add(1);
+		if (sleeping.load() > 0) {
+			// A thread that has not seen the new task yet holds the mutex until
+			// it waits, so taking it here can not miss the wake-up.
+			{ std::lock_guard<std::mutex> lock(mutex); }
+			ready.notify_one();
+		}
+	}
+
+	bool take(std::size_t index, task_type &task) {
+		{
+			auto &own(queues[index]);
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.tasks.empty()) {
+				task = std::move(own.tasks.back());
+				own.tasks.pop_back();
+				return true;
+			}
+		}
+		for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+			auto &victim(queues[(index + offset) % queues.size()]);
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tasks.empty()) {
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void work(std::size_t index) {
+		current_worker() = worker_type{ this, index };
+		bool idle(false);
+		for (;;) {
+			task_type task;
+			if (take(index, task)) {
+				idle = false;
+				pending.fetch_sub(1);
+				task();
+				continue;
+			}
+			if (!idle) {
+				// Let the submitting thread run before going to sleep.
+				idle = true;
+				std::this_thread::yield();
+				continue;
+			}
+			idle = false;
+			std::unique_lock<std::mutex> lock(mutex);
+			sleeping.fetch_add(1);
+			ready.wait(lock, [this]() { return stopping || pending.load() > 0; });
+			sleeping.fetch_sub(1);
+			if (stopping && pending.load() <= 0) {
+				return;
+			}
+		}
+	}
+
+	std::vector<queue_type> queues;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable ready;
+	std::atomic<std::ptrdiff_t> pending{ 0 };
+	std::atomic<std::size_t> sleeping{ 0 };
+	std::atomic<std::size_t> next_queue{ 0 };
+	std::size_t chunk_size;
+	bool stopping = false;
+};
+
+} // namespace frp
+
+#endif // _FRP_THREAD_POOL_H_
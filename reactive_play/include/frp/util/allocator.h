@@ -0,0 +1,235 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_ALLOCATOR_H_
+#define _FRP_UTIL_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace frp {
+namespace util {
+
+// Blocks of any size, kept by size once deallocated and handed out again for
+// the same size.
+//
+// A commit usually allocates blocks of the same size as the commit it
+// replaces, so once a pipeline has run a few commits it takes every block from
+// the pool. Blocks are returned to the system when the pool is destroyed.
+struct block_pool_type {
+
+	block_pool_type() = default;
+	block_pool_type(const block_pool_type &) = delete;
+	block_pool_type &operator=(const block_pool_type &) = delete;
+
+	~block_pool_type() {
+		for (auto &free : free_lists) {
+			while (free.second) {
+				::operator delete(std::exchange(free.second, free.second->next));
+			}
+		}
+	}
+
+	void *allocate(std::size_t size) {
+		size = block_size(size);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it(free_lists.find(size));
+			if (it != free_lists.end() && it->second) {
+				return std::exchange(it->second, it->second->next);
+			}
+		}
+		return ::operator new(size);
+	}
+
+	void deallocate(void *pointer, std::size_t size) {
+		auto block(static_cast<block_type *>(pointer));
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &free(free_lists[block_size(size)]);
+		block->next = free;
+		free = block;
+	}
+
+private:
+	struct block_type {
+		block_type *next;
+	};
+
+	static std::size_t block_size(std::size_t size) {
+		return std::max(size, sizeof(block_type));
+	}
+
+	std::mutex mutex;
+	std::map<std::size_t, block_type *> free_lists;
+};
+
+template<typename T>
+struct pool_allocator_type {
+
+	template<typename U>
+	friend struct pool_allocator_type;
+
+	typedef T value_type;
+
+	static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+	explicit pool_allocator_type(std::shared_ptr<block_pool_type> pool
+			= std::make_shared<block_pool_type>())
+		: pool(std::move(pool)) {}
+
+	pool_allocator_type(const pool_allocator_type &) = default;
+
+	template<typename U>
+	pool_allocator_type(const pool_allocator_type<U> &other) : pool(other.pool) {}
+
+	T *allocate(std::size_t count) {
+		return static_cast<T *>(pool->allocate(count * sizeof(T)));
+	}
+
+	void deallocate(T *pointer, std::size_t count) {
+		pool->deallocate(pointer, count * sizeof(T));
+	}
+
+	template<typename U>
+	bool operator==(const pool_allocator_type<U> &other) const {
+		return pool == other.pool;
+	}
+
+	template<typename U>
+	bool operator!=(const pool_allocator_type<U> &other) const {
+		return pool != other.pool;
+	}
+
+private:
+	std::shared_ptr<block_pool_type> pool;
+};
+
+// Memory handed out from large chunks by bumping a pointer.
+//
+// Every chunk counts the allocations made from it that are still in use, and
+// is rewound once they are all deallocated. A commit is released when the
+// commit after it replaces it, so a long-lived pipeline takes its values from
+// the same few chunks over and over. Chunks are returned to the system when
+// the arena is destroyed.
+struct arena_type {
+
+	explicit arena_type(std::size_t chunk_size = 1 << 20) : chunk_size(chunk_size) {}
+
+	arena_type(const arena_type &) = delete;
+	arena_type &operator=(const arena_type &) = delete;
+
+	~arena_type() {
+		for (auto &chunk : chunks) {
+			::operator delete(chunk.first);
+		}
+	}
+
+	void *allocate(std::size_t size, std::size_t alignment) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto offset(current == chunks.end() ? 0
+			: (current->second.used + alignment - 1) / alignment * alignment);
+		if (current == chunks.end() || offset + size > current->second.size) {
+			current = take_chunk(size);
+			offset = 0;
+		}
+		current->second.used = offset + size;
+		++current->second.live;
+		return current->first + offset;
+	}
+
+	void deallocate(void *pointer) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto chunk(std::prev(chunks.upper_bound(static_cast<char *>(pointer))));
+		if (--chunk->second.live == 0) {
+			chunk->second.used = 0;
+		}
+	}
+
+private:
+	struct chunk_type {
+		std::size_t size;
+		std::size_t used;
+		std::size_t live;
+	};
+
+	typedef std::map<char *, chunk_type> chunks_type;
+
+	// A released chunk large enough for size, or a new one.
+	chunks_type::iterator take_chunk(std::size_t size) {
+		for (auto it(chunks.begin()); it != chunks.end(); ++it) {
+			if (it != current && it->second.live == 0 && it->second.size >= size) {
+				return it;
+			}
+		}
+		auto chunk(std::max(size, chunk_size));
+		return chunks.emplace(static_cast<char *>(::operator new(chunk)),
+			chunk_type{ chunk, 0, 0 }).first;
+	}
+
+	std::mutex mutex;
+	chunks_type chunks;
+	chunks_type::iterator current = chunks.end();
+	std::size_t chunk_size;
+};
+
+template<typename T>
+struct arena_allocator_type {
+
+	template<typename U>
+	friend struct arena_allocator_type;
+
+	typedef T value_type;
+
+	static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+	explicit arena_allocator_type(std::shared_ptr<arena_type> arena
+			= std::make_shared<arena_type>())
+		: arena(std::move(arena)) {}
+
+	arena_allocator_type(const arena_allocator_type &) = default;
+
+	template<typename U>
+	arena_allocator_type(const arena_allocator_type<U> &other) : arena(other.arena) {}
+
+	T *allocate(std::size_t count) {
+		return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *pointer, std::size_t) {
+		arena->deallocate(pointer);
+	}
+
+	template<typename U>
+	bool operator==(const arena_allocator_type<U> &other) const {
+		return arena == other.arena;
+	}
+
+	template<typename U>
+	bool operator!=(const arena_allocator_type<U> &other) const {
+		return arena != other.arena;
+	}
+
+private:
+	std::shared_ptr<arena_type> arena;
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_ALLOCATOR_H_
@@ -18,6 +18,7 @@
 #include <cassert>
 #include <frp/util/list.h>
 #include <functional>
+#include <memory>
 
 namespace frp {
 
@@ -52,10 +53,11 @@ struct fixed_size_collector_type {
 
 	explicit fixed_size_collector_type(std::size_t size, Allocator &&allocator = Allocator(),
 		const Comparator &comparator = Comparator())
-		: storage(allocator.allocate(size), deleter_type{ *this })
+		: allocator(std::move(allocator))
+		, storage(this->allocator.allocate(size), deleter_type{ *this })
+		, comparator(comparator)
 		, storage_size(0)
-		, capacity(size)
-		, comparator(comparator) {}
+		, capacity(size) {}
 
 	fixed_size_collector_type(fixed_size_collector_type &&) = delete;
 
@@ -70,15 +72,30 @@ struct fixed_size_collector_type {
 		return size == capacity;
 	}
 
+	// Constructs without counting; complete() counts a whole range at once.
+	template<typename... Args>
+	void emplace(std::size_t index, Args&&... args) {
+		assert(index < capacity);
+		std::allocator_traits<Allocator>::construct(allocator, &storage[index],
+			std::forward<Args>(args)...);
+	}
+
+	bool complete(std::size_t count) {
+		auto size(storage_size += count);
+		assert(size <= capacity);
+		return size == capacity;
+	}
+
 	std::size_t size() const {
 		return storage_size;
 	}
 
 private:
 	typedef std::unique_ptr<T[], deleter_type> storage_type;
+	// Declared first, since storage is allocated with it.
+	Allocator allocator;
 	storage_type storage;
 	Comparator comparator;
-	Allocator allocator;
 	std::atomic_size_t storage_size;
 	std::size_t capacity;
 };
@@ -96,9 +113,9 @@ struct append_collector_type {
 
 	explicit append_collector_type(std::size_t size, Allocator &&allocator = Allocator(),
 		const Comparator &comparator = Comparator())
-		: storage(allocator.allocate(size), deleter_type{ *this })
+		: allocator(std::move(allocator))
+		, storage(this->allocator.allocate(size), deleter_type{ *this })
 		, comparator(comparator)
-		, allocator(allocator)
 		, storage_size(0)
 		, capacity(size)
 		, counter(0) {}
@@ -119,15 +136,31 @@ struct append_collector_type {
 		return ++counter == capacity;
 	}
 
+	// Appends without counting; complete() counts a whole range of appended and
+	// skipped values at once.
+	template<typename... Args>
+	void emplace(Args&&... args) {
+		std::size_t index(storage_size++);
+		assert(index < capacity);
+
+		std::allocator_traits<Allocator>::construct(allocator, &storage[index],
+			std::forward<Args>(args)...);
+	}
+
+	bool complete(std::size_t count) {
+		return (counter += count) == capacity;
+	}
+
 	std::size_t size() const {
 		return storage_size;
 	}
 
 private:
 	typedef std::unique_ptr<T[], deleter_type> storage_type;
+	// Declared first, since storage is allocated with it.
+	Allocator allocator;
 	storage_type storage;
 	Comparator comparator;
-	Allocator allocator;
 	std::atomic_size_t storage_size;
 	std::size_t capacity;
 	std::atomic_size_t counter;
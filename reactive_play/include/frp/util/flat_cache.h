@@ -0,0 +1,128 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_FLAT_CACHE_H_
+#define _FRP_UTIL_FLAT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+namespace frp {
+namespace util {
+
+// Open addressing table from keys to values that live elsewhere.
+//
+// Slots are kept in one contiguous buffer and probed linearly; a slot only
+// points at its key and value, so neither is copied, and both must outlive the
+// table. The buffer can be released and handed to the next table, which keeps
+// its capacity.
+template<typename K, typename V, typename Hash = std::hash<K>,
+	typename KeyEqual = std::equal_to<K>>
+struct flat_cache_type {
+
+	struct slot_type {
+		const K *key;
+		const V *value;
+	};
+
+	typedef std::vector<slot_type> buffer_type;
+
+	explicit flat_cache_type(buffer_type &&buffer = buffer_type(), const Hash &hash = Hash(),
+		const KeyEqual &equal = KeyEqual())
+		: slots(std::move(buffer)), hash(hash), equal(equal) {
+		slots.clear();
+	}
+
+	// Maps each key to the value at the same position; the first of equal keys
+	// wins.
+	template<typename Keys, typename Values>
+	void assign(const Keys &keys, const Values &values) {
+		std::size_t size(std::distance(std::begin(keys), std::end(keys)));
+		// At most half full.
+		bits = 1;
+		while ((std::size_t(1) << bits) < 2 * size) {
+			++bits;
+		}
+		slots.assign(std::size_t(1) << bits, slot_type{ nullptr, nullptr });
+
+		auto value(std::begin(values));
+		for (auto key = std::begin(keys); key != std::end(keys); ++key, ++value) {
+			auto &slot(probe(*key));
+			if (!slot.key) {
+				slot = slot_type{ &*key, &*value };
+			}
+		}
+	}
+
+	const V *find(const K &key) const {
+		return slots.empty() ? nullptr : probe(key).value;
+	}
+
+	// Empties the table and gives up its buffer.
+	buffer_type release() {
+		return std::move(slots);
+	}
+
+private:
+	// The slot holding key, or the empty slot where it belongs.
+	slot_type &probe(const K &key) const {
+		auto mask((std::size_t(1) << bits) - 1);
+		// Fibonacci hashing spreads keys whose hashes only differ in high bits.
+		auto index(std::size_t((std::uint64_t(hash(key)) * 0x9e3779b97f4a7c15ull) >> (64 - bits)));
+		while (slots[index].key && !equal(*slots[index].key, key)) {
+			index = (index + 1) & mask;
+		}
+		return const_cast<slot_type &>(slots[index]);
+	}
+
+	buffer_type slots;
+	std::size_t bits = 1;
+	Hash hash;
+	KeyEqual equal;
+};
+
+// Buffers of released tables, kept for the next ones.
+template<typename Buffer>
+struct buffer_recycler_type {
+
+	Buffer take() {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (buffers.empty()) {
+			return {};
+		}
+		auto buffer(std::move(buffers.back()));
+		buffers.pop_back();
+		return buffer;
+	}
+
+	void give(Buffer &&buffer) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (buffers.size() < limit && buffer.capacity() > 0) {
+			buffers.push_back(std::move(buffer));
+		}
+	}
+
+private:
+	static constexpr std::size_t limit = 2;
+
+	std::mutex mutex;
+	std::vector<Buffer> buffers;
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_FLAT_CACHE_H_
@@ -13,7 +13,8 @@
 #ifndef _FRP_UTIL_OBSERVABLE_H_
 #define _FRP_UTIL_OBSERVABLE_H_
 
-#include <frp/util/list.h>
+#include <frp/util/propagation.h>
+#include <frp/util/registry.h>
 #include <functional>
 #include <memory>
 
@@ -23,7 +24,7 @@ namespace util {
 struct observable_type {
 
 	typedef std::function<void()> callback_type;
-	typedef single_list_type<callback_type> callback_container_type;
+	typedef registry_type<callback_type> callback_container_type;
 
 	struct reference_type {
 
@@ -35,7 +36,7 @@ struct observable_type {
 				: iterator(iterator), observable(observable) {}
 
 			~storage_type() {
-				observable.callbacks.erase(std::move(iterator));
+				observable.callbacks.erase(iterator);
 			}
 		};
 
@@ -49,8 +50,10 @@ struct observable_type {
 	}
 
 	void update() const {
-		callbacks.for_each([](const auto &callback) {
-			callback();
+		propagation_type::run([this]() {
+			callbacks.for_each([](const auto &callback) {
+				callback();
+			});
 		});
 	}
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_POOL_H_
+#define _FRP_UTIL_POOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace frp {
+namespace util {
+
+// Fixed size blocks for objects of type T.
+//
+// Each thread keeps its own free list, so allocate and deallocate neither lock
+// nor use atomics unless a thread runs out of blocks or holds too many; the
+// surplus goes through a shared list. Blocks are never returned to the system,
+// which keeps memory type-stable: a pointer to a released block still points
+// to a block for T, which storage_ptr relies on.
+template<typename T>
+struct pool_type {
+
+	static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+	static void *allocate() {
+		auto &local(local_list());
+		if (!local.head) {
+			refill(local);
+		}
+		auto node(local.head);
+		local.head = node->next;
+		--local.size;
+		return &node->storage;
+	}
+
+	static void deallocate(void *pointer) {
+		auto node(reinterpret_cast<node_type *>(pointer));
+		auto &local(local_list());
+		node->next = local.head;
+		local.head = node;
+		if (++local.size > local_limit) {
+			spill(local, local_limit / 2);
+		}
+	}
+
+private:
+	static constexpr std::size_t chunk_size = 64;
+	static constexpr std::size_t local_limit = 4 * chunk_size;
+
+	// The link does not overlap the object, so fields of a released object,
+	// like its reference count, are left untouched.
+	struct node_type {
+		alignas(T) unsigned char storage[sizeof(T)];
+		node_type *next;
+	};
+
+	struct list_type {
+		node_type *head = nullptr;
+		std::size_t size = 0;
+	};
+
+	struct local_list_type : list_type {
+		~local_list_type() {
+			spill(*this, list_type::size);
+		}
+	};
+
+	struct shared_list_type : list_type {
+		std::mutex mutex;
+	};
+
+	static list_type &local_list() {
+		thread_local local_list_type list;
+		return list;
+	}
+
+	static shared_list_type &shared_list() {
+		static auto list(new shared_list_type());
+		return *list;
+	}
+
+	static void refill(list_type &local) {
+		{
+			auto &shared(shared_list());
+			std::lock_guard<std::mutex> lock(shared.mutex);
+			for (; shared.head && local.size < chunk_size; ++local.size) {
+				auto node(shared.head);
+				shared.head = node->next;
+				--shared.size;
+				node->next = local.head;
+				local.head = node;
+			}
+		}
+		if (!local.head) {
+			auto chunk(static_cast<node_type *>(::operator new(sizeof(node_type) * chunk_size)));
+			for (std::size_t i = 0; i < chunk_size; ++i) {
+				chunk[i].next = local.head;
+				local.head = &chunk[i];
+			}
+			local.size = chunk_size;
+		}
+	}
+
+	static void spill(list_type &local, std::size_t count) {
+		auto &shared(shared_list());
+		std::lock_guard<std::mutex> lock(shared.mutex);
+		for (; local.head && count > 0; --count, --local.size) {
+			auto node(local.head);
+			local.head = node->next;
+			node->next = shared.head;
+			shared.head = node;
+			++shared.size;
+		}
+	}
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_POOL_H_
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_PROPAGATION_H_
+#define _FRP_UTIL_PROPAGATION_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace frp {
+namespace util {
+
+// Repositories waiting to be evaluated by the propagation running on this
+// thread.
+//
+// Sources have depth 0 and a repository is one deeper than its deepest
+// dependency, so evaluating in depth order evaluates every repository after
+// all of its dependencies, and once per propagation even when several of them
+// changed. The outermost update() on a thread opens the propagation and
+// evaluates everything scheduled while it runs.
+//
+// The queue is kept per thread and reused, so a propagation does not allocate
+// once it has seen as many pending repositories before.
+struct propagation_type {
+
+	typedef std::shared_ptr<const std::function<void()>> evaluate_type;
+
+	static std::size_t next_order() {
+		static std::atomic_size_t last(0);
+		return ++last;
+	}
+
+	// Evaluates now if no propagation is running on this thread, otherwise
+	// once, after every repository of lower depth scheduled in it.
+	static void schedule(std::size_t depth, std::size_t order, const evaluate_type &evaluate) {
+		auto &propagation(current());
+		if (propagation.running) {
+			propagation.pending.push_back(entry_type{ depth, order, evaluate });
+			std::push_heap(propagation.pending.begin(), propagation.pending.end());
+		} else {
+			(*evaluate)();
+		}
+	}
+
+	// Runs update, and then all repositories it scheduled, unless a
+	// propagation is already running on this thread.
+	template<typename F>
+	static void run(F &&update) {
+		auto &propagation(current());
+		if (propagation.running) {
+			update();
+			return;
+		}
+
+		propagation.running = true;
+		try {
+			update();
+			propagation.drain();
+		} catch (...) {
+			propagation.pending.clear();
+			propagation.running = false;
+			throw;
+		}
+		propagation.running = false;
+	}
+
+private:
+	struct entry_type {
+		std::size_t depth;
+		std::size_t order;
+		evaluate_type evaluate;
+
+		// Reversed, so the heap yields the shallowest repository first.
+		bool operator<(const entry_type &entry) const {
+			return std::tie(entry.depth, entry.order) < std::tie(depth, order);
+		}
+
+		bool operator==(const entry_type &entry) const {
+			return depth == entry.depth && order == entry.order;
+		}
+	};
+
+	static propagation_type &current() {
+		thread_local propagation_type propagation;
+		return propagation;
+	}
+
+	entry_type pop() {
+		std::pop_heap(pending.begin(), pending.end());
+		auto entry(std::move(pending.back()));
+		pending.pop_back();
+		return entry;
+	}
+
+	void drain() {
+		while (!pending.empty()) {
+			auto entry(pop());
+			// Repositories scheduled by several dependencies are evaluated once.
+			while (!pending.empty() && pending.front() == entry) {
+				pop();
+			}
+			(*entry.evaluate)();
+		}
+	}
+
+	std::vector<entry_type> pending;
+	bool running = false;
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_PROPAGATION_H_
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_REGISTRY_H_
+#define _FRP_UTIL_REGISTRY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace frp {
+namespace util {
+
+// Values kept in an immutable, contiguous snapshot.
+//
+// for_each walks the current snapshot without locking or touching reference
+// counts; it only registers with the current epoch. insert and erase copy the
+// snapshot under a mutex, publish the copy and retire the old one, which is
+// deleted once the epoch has advanced twice. The epoch only advances when no
+// reader is registered with the previous one.
+//
+// for_each is reentrant: it may call insert and erase. Values erased while a
+// for_each is running may still be visited by it.
+template<typename T>
+struct registry_type {
+
+	typedef std::size_t iterator;
+
+	registry_type() = default;
+	registry_type(const registry_type &) = delete;
+	registry_type &operator=(const registry_type &) = delete;
+
+	~registry_type() {
+		delete current.load();
+		for (auto retired_snapshot : retired) {
+			delete_retired(retired_snapshot);
+		}
+	}
+
+	template<typename F>
+	void for_each(F &&f) const {
+		read_guard guard(*this);
+		auto snapshot(current.load());
+		if (snapshot) {
+			for (const auto &entry : snapshot->entries) {
+				f(entry.value);
+			}
+		}
+	}
+
+	template<typename U>
+	iterator insert(U &&value) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto previous(current.load());
+		auto next(std::make_unique<snapshot_type>());
+		if (previous) {
+			next->entries.reserve(previous->entries.size() + 1);
+			next->entries.insert(next->entries.end(), previous->entries.begin(),
+				previous->entries.end());
+		}
+		auto id(++last_id);
+		next->entries.push_back(entry_type{ id, std::forward<U>(value) });
+		publish(previous, next.release());
+		return id;
+	}
+
+	bool erase(iterator id) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto previous(current.load());
+		if (!previous) {
+			return false;
+		}
+		auto &entries(previous->entries);
+		auto it(std::find_if(entries.begin(), entries.end(), [id](const auto &entry) {
+			return entry.id == id;
+		}));
+		if (it == entries.end()) {
+			return false;
+		}
+		std::unique_ptr<snapshot_type> next;
+		if (entries.size() > 1) {
+			next = std::make_unique<snapshot_type>();
+			next->entries.reserve(entries.size() - 1);
+			next->entries.insert(next->entries.end(), entries.begin(), it);
+			next->entries.insert(next->entries.end(), std::next(it), entries.end());
+		}
+		publish(previous, next.release());
+		return true;
+	}
+
+private:
+	struct entry_type {
+		iterator id;
+		T value;
+	};
+
+	struct snapshot_type {
+		std::vector<entry_type> entries;
+		snapshot_type *next_retired = nullptr;
+	};
+
+	struct read_guard {
+		explicit read_guard(const registry_type &registry)
+			: readers(registry.readers[registry.epoch.load() % 2]) {
+			++readers;
+		}
+
+		~read_guard() {
+			--readers;
+		}
+
+		std::atomic_size_t &readers;
+	};
+
+	void publish(snapshot_type *previous, snapshot_type *next) {
+		current.store(next);
+		if (previous) {
+			auto &list(retired[epoch.load() % 3]);
+			previous->next_retired = list;
+			list = previous;
+		}
+		collect();
+	}
+
+	// A snapshot retired during epoch E can only be walked by readers that
+	// registered before it was replaced, so it is deleted when the epoch
+	// reaches E + 2.
+	void collect() {
+		auto first(epoch.load());
+		for (auto e = first; e < first + 2; ++e) {
+			if (readers[(e + 1) % 2].load() > 0) {
+				break;
+			}
+			epoch.store(e + 1);
+			delete_retired(std::exchange(retired[(e + 2) % 3], nullptr));
+		}
+	}
+
+	static void delete_retired(snapshot_type *snapshot) {
+		while (snapshot) {
+			delete std::exchange(snapshot, snapshot->next_retired);
+		}
+	}
+
+	std::atomic<snapshot_type *> current{ nullptr };
+	std::atomic_size_t epoch{ 0 };
+	mutable std::atomic_size_t readers[2]{ { 0 }, { 0 } };
+	snapshot_type *retired[3]{ nullptr, nullptr, nullptr };
+	std::mutex mutex;
+	iterator last_id = 0;
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_REGISTRY_H_
@@ -16,6 +16,7 @@
 #include <array>
 #include <cstdint>
 #include <frp/util/observable.h>
+#include <frp/util/storage_ptr.h>
 #include <memory>
 
 namespace frp {
@@ -33,7 +34,7 @@ typedef uint64_t revision_type;
 constexpr revision_type default_revision = 0;
 
 template<typename T>
-struct storage_type {
+struct storage_type : counted_type {
 	T value;
 	revision_type revision;
 
@@ -54,7 +55,7 @@ struct storage_type {
 };
 
 template<>
-struct storage_type<void> {
+struct storage_type<void> : counted_type {
 	revision_type revision;
 
 	storage_type(revision_type revision) : revision(revision) {}
@@ -77,7 +78,7 @@ struct commit_storage_type : storage_type<T> {
 
 	template<typename F>
 	static auto make(F &&function, const revisions_type &revisions) {
-		return std::make_shared<commit_storage_type<T, DependenciesN>>(function(),
+		return make_storage<commit_storage_type<T, DependenciesN>>(function(),
 			default_revision, revisions);
 	}
 
@@ -98,7 +99,7 @@ struct commit_storage_type<void, DependenciesN> : storage_type<void> {
 	template<typename F>
 	static auto make(F &&function, const revisions_type &revisions) {
 		function();
-		return std::make_shared<commit_storage_type<void, DependenciesN>>(default_revision,
+		return make_storage<commit_storage_type<void, DependenciesN>>(default_revision,
 			revisions);
 	}
 
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_STORAGE_PTR_H_
+#define _FRP_UTIL_STORAGE_PTR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <frp/util/pool.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace frp {
+namespace util {
+
+// Intrusive reference count of pooled storage.
+//
+// The count is deliberately left alone by the constructor: make_storage sets it
+// once the object is constructed. A reader holding a stale pointer can then
+// still look at the count of a released object, see zero, and retry.
+struct counted_type {
+	counted_type() {}
+	counted_type(const counted_type &) = delete;
+	counted_type &operator=(const counted_type &) = delete;
+
+	mutable std::atomic_size_t references;
+	void (*dispose)(const counted_type *);
+
+	void add_reference() const {
+		references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool try_add_reference() const {
+		auto count(references.load(std::memory_order_relaxed));
+		while (count != 0) {
+			if (references.compare_exchange_weak(count, count + 1, std::memory_order_acquire,
+					std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void remove_reference() const {
+		if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			dispose(this);
+		}
+	}
+};
+
+template<typename T>
+struct storage_ptr {
+
+	template<typename U>
+	friend struct storage_ptr;
+
+	storage_ptr() = default;
+
+	storage_ptr(std::nullptr_t) {}
+
+	// Adopts a reference that was already added to pointer.
+	explicit storage_ptr(T *pointer) : pointer(pointer) {}
+
+	storage_ptr(const storage_ptr &copy) : pointer(copy.pointer) {
+		if (pointer) {
+			pointer->add_reference();
+		}
+	}
+
+	storage_ptr(storage_ptr &&copy) : pointer(copy.pointer) {
+		copy.pointer = nullptr;
+	}
+
+	template<typename U, typename = std::enable_if_t<std::is_convertible<U *, T *>::value>>
+	storage_ptr(const storage_ptr<U> &copy) : pointer(copy.pointer) {
+		if (pointer) {
+			pointer->add_reference();
+		}
+	}
+
+	template<typename U, typename = std::enable_if_t<std::is_convertible<U *, T *>::value>>
+	storage_ptr(storage_ptr<U> &&copy) : pointer(copy.pointer) {
+		copy.pointer = nullptr;
+	}
+
+	~storage_ptr() {
+		reset();
+	}
+
+	storage_ptr &operator=(storage_ptr copy) {
+		std::swap(pointer, copy.pointer);
+		return *this;
+	}
+
+	void reset() {
+		if (pointer) {
+			pointer->remove_reference();
+			pointer = nullptr;
+		}
+	}
+
+	// Gives up ownership of the reference without removing it.
+	T *release() {
+		auto released(pointer);
+		pointer = nullptr;
+		return released;
+	}
+
+	T *get() const {
+		return pointer;
+	}
+
+	T &operator*() const {
+		return *pointer;
+	}
+
+	T *operator->() const {
+		return pointer;
+	}
+
+	explicit operator bool() const {
+		return pointer != nullptr;
+	}
+
+	bool operator==(const storage_ptr &other) const {
+		return pointer == other.pointer;
+	}
+
+	bool operator!=(const storage_ptr &other) const {
+		return pointer != other.pointer;
+	}
+
+private:
+	T *pointer = nullptr;
+};
+
+// Constructs T in storage taken from pool_type<T>.
+template<typename T, typename... Args>
+storage_ptr<T> make_storage(Args &&... args) {
+	auto memory(pool_type<T>::allocate());
+	T *pointer;
+	try {
+		pointer = ::new (memory) T(std::forward<Args>(args)...);
+	} catch (...) {
+		pool_type<T>::deallocate(memory);
+		throw;
+	}
+	pointer->dispose = [](const counted_type *counted) {
+		auto object(static_cast<const T *>(counted));
+		object->~T();
+		pool_type<T>::deallocate(const_cast<T *>(object));
+	};
+	pointer->references.store(1, std::memory_order_relaxed);
+	return storage_ptr<T>(pointer);
+}
+
+// Atomically replaceable storage_ptr.
+//
+// load() reads the pointer, adds a reference unless the count already dropped
+// to zero, and checks that the pointer was not replaced meanwhile. Pooled
+// storage is never returned to the system, so touching the count of an object
+// that was released in between is harmless.
+template<typename T>
+struct atomic_storage_ptr {
+
+	atomic_storage_ptr() = default;
+
+	explicit atomic_storage_ptr(storage_ptr<T> &&value) : pointer(value.release()) {}
+
+	atomic_storage_ptr(const atomic_storage_ptr &) = delete;
+	atomic_storage_ptr &operator=(const atomic_storage_ptr &) = delete;
+
+	~atomic_storage_ptr() {
+		storage_ptr<T> previous(pointer.load(std::memory_order_relaxed));
+	}
+
+	storage_ptr<T> load() const {
+		for (;;) {
+			auto current(pointer.load(std::memory_order_acquire));
+			if (!current) {
+				return {};
+			}
+			if (current->try_add_reference()) {
+				if (pointer.load(std::memory_order_acquire) == current) {
+					return storage_ptr<T>(current);
+				}
+				current->remove_reference();
+			}
+		}
+	}
+
+	// The current pointer, without a reference. It may only be dereferenced
+	// while the caller holds a reference to it, e.g. once it compared equal to
+	// a pointer the caller owns.
+	T *peek() const {
+		return pointer.load(std::memory_order_acquire);
+	}
+
+	void store(storage_ptr<T> value) {
+		storage_ptr<T> previous(pointer.exchange(value.release(), std::memory_order_acq_rel));
+	}
+
+	// Replaces expected with desired if expected is current; otherwise loads the
+	// current value into expected.
+	bool compare_exchange(storage_ptr<T> &expected, const storage_ptr<T> &desired) {
+		auto current(expected.get());
+		if (desired) {
+			desired->add_reference();
+		}
+		if (pointer.compare_exchange_strong(current, desired.get(), std::memory_order_acq_rel)) {
+			// Drops the reference the atomic held; expected still holds its own.
+			if (expected) {
+				expected->remove_reference();
+			}
+			return true;
+		}
+		if (desired) {
+			desired->remove_reference();
+		}
+		expected = load();
+		return false;
+	}
+
+private:
+	std::atomic<T *> pointer{ nullptr };
+};
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_STORAGE_PTR_H_
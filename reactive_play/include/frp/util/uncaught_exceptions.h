@@ -0,0 +1,35 @@
+/*
+ * Copyright 2016 Google Inc. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FRP_UTIL_UNCAUGHT_EXCEPTIONS_H_
+#define _FRP_UTIL_UNCAUGHT_EXCEPTIONS_H_
+
+#include <exception>
+
+namespace frp {
+namespace util {
+
+// The number of exceptions unwinding the stack of the calling thread. Before
+// C++17 it can only tell whether there is one, so an object created while
+// unwinding can not tell a new exception from the one already in flight.
+inline int uncaught_exceptions() noexcept {
+#if defined(__cpp_lib_uncaught_exceptions)
+	return std::uncaught_exceptions();
+#else
+	return std::uncaught_exception() ? 1 : 0;
+#endif
+}
+
+} // namespace util
+} // namespace frp
+
+#endif // _FRP_UTIL_UNCAUGHT_EXCEPTIONS_H_
@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <utility>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable {
+
+namespace detail {
+
+//! Expressions waiting to be evaluated when the current batch is committed.
+//!
+//! Expressions are keyed by their creation order. An expression can only depend
+//! on values that existed when it was created, so evaluating them in this order
+//! evaluates every expression after the expressions it depends on.
+//!
+//! \ingroup observable_detail
+class batch_queue final
+{
+public:
+    //! Return the queue of the batch that is open on the calling thread, or
+    //! nullptr if there is none.
+    static auto current() noexcept -> batch_queue * & {
+        thread_local batch_queue * queue = nullptr;
+        return queue;
+    }
+
+    //! Return a new, unique, creation order for an expression.
+    static auto next_order() noexcept
+    {
+        static std::atomic<std::size_t> last { 0 };
+        return ++last;
+    }
+
+    //! Queue an expression for evaluation. Queueing the same expression again
+    //! before it has been evaluated does nothing.
+    void push(std::size_t order, std::function<void()> eval)
+    {
+        pending_.emplace(order, std::move(eval));
+    }
+
+    //! Remove an expression from the queue, if queued.
+    void remove(std::size_t order) noexcept { pending_.erase(order); }
+
+    //! Drop all queued expressions without evaluating them.
+    void clear() noexcept { pending_.clear(); }
+
+    //! Evaluate all queued expressions, including the ones queued while
+    //! evaluating, in creation order.
+    void run()
+    {
+        while(!pending_.empty())
+        {
+            auto const first = pending_.begin();
+            auto const eval = std::move(first->second);
+            pending_.erase(first);
+
+            eval();
+        }
+    }
+
+private:
+    std::map<std::size_t, std::function<void()>> pending_;
+};
+
+}
+
+//! Group changes to several values, so the expressions that depend on them are
+//! evaluated once, when the batch is committed.
+//!
+//! While a batch is open on a thread, setting a value still notifies the value's
+//! own observers, but expressions observed with ``observe()`` are not evaluated.
+//! They are evaluated when the batch is committed, each one only once and after
+//! all the expressions it depends on, so no observer sees a partially updated
+//! result.
+//!
+//! Batches can be nested; only the outermost batch commits.
+//!
+//! Example:
+//!
+//!     {
+//!         observable::batch b;
+//!         x = 1;
+//!         y = 2;
+//!     } // Expressions depending on x and y are evaluated here.
+//!
+//! \warning A batch only applies to the thread that created it.
+//!
+//! \ingroup observable
+class batch final
+{
+public:
+    //! Open a batch on the calling thread.
+    batch() noexcept
+    {
+        auto & current = detail::batch_queue::current();
+        if(current)
+            return;
+
+        current = &queue_;
+        owner_ = true;
+    }
+
+    //! Evaluate all expressions that depend on values changed since the batch
+    //! was opened or last committed.
+    //!
+    //! The batch stays open. Nested batches do nothing when committed.
+    //!
+    //! If evaluating an expression throws, the expressions still queued are
+    //! dropped, the batch is closed and the exception is rethrown.
+    void commit()
+    {
+        if(!owner_)
+            return;
+
+        try
+        {
+            queue_.run();
+        }
+        catch(...)
+        {
+            close();
+            throw;
+        }
+    }
+
+    //! Commit and close the batch.
+    //!
+    //! If the batch is destroyed while an exception is unwinding the stack,
+    //! the queued expressions are dropped instead of evaluated. Exceptions
+    //! thrown while evaluating are not propagated from the destructor; call
+    //! commit() explicitly to see them.
+    ~batch()
+    {
+        if(!owner_)
+            return;
+
+        if(std::uncaught_exceptions() == uncaught_)
+        {
+            try
+            {
+                queue_.run();
+            }
+            catch(...)
+            {
+            }
+        }
+
+        close();
+    }
+
+public:
+    //! Batches are not copy-constructible.
+    batch(batch const &) =delete;
+
+    //! Batches are not copy-assignable.
+    auto operator=(batch const &) -> batch & =delete;
+
+    //! Batches are not move-constructible.
+    batch(batch &&) =delete;
+
+    //! Batches are not move-assignable.
+    auto operator=(batch &&) -> batch & =delete;
+
+private:
+    //! Drop the queued expressions and stop collecting them on this thread.
+    void close() noexcept
+    {
+        queue_.clear();
+        detail::batch_queue::current() = nullptr;
+        owner_ = false;
+    }
+
+private:
+    detail::batch_queue queue_;
+    int const uncaught_ { std::uncaught_exceptions() };
+    bool owner_ { false };
+};
+
+}
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
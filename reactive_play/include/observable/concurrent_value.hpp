@@ -0,0 +1,383 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <observable/subject.hpp>
+#include <observable/subscription.hpp>
+#include <observable/value.hpp>
+#include <observable/detail/type_traits.hpp>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable {
+
+namespace detail {
+
+//! Storage for trivially copyable values, protected by a sequence lock.
+//!
+//! The value's bytes are kept in atomic words. A writer makes the sequence
+//! number odd, writes the words and makes it even again; a reader copies the
+//! words and retries if the sequence number was odd or has changed meanwhile.
+//! Readers never write shared memory, so they do not slow each other down.
+//!
+//! \warning Only one store() can run at a time.
+//! \ingroup observable_detail
+template <typename ValueType>
+class seqlock_storage final
+{
+    using word = std::uintptr_t;
+    static constexpr std::size_t word_count = (sizeof(ValueType) + sizeof(word) - 1) / sizeof(word);
+    static constexpr std::size_t alignment = alignof(ValueType) > alignof(word) ?
+                                                alignof(ValueType) : alignof(word);
+
+    struct alignas(alignment) words_type { word w[word_count]; };
+
+public:
+    //! Value returned by store().
+    using stored_type = ValueType;
+
+    explicit seqlock_storage(ValueType const & initial_value) noexcept { store(initial_value); }
+
+    //! Return a copy of the stored value. Never blocks.
+    auto load() const noexcept -> ValueType
+    {
+        words_type copy;
+
+        for(;;)
+        {
+            auto const before = sequence_.load(std::memory_order_acquire);
+            if(before & 1)
+                continue;
+
+            for(std::size_t i = 0; i < word_count; ++i)
+                copy.w[i] = words_[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(sequence_.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        return *std::launder(reinterpret_cast<ValueType const *>(&copy));
+    }
+
+    //! Return the stored value, as seen by the writer. Only call it while no
+    //! store() can run.
+    auto load_for_writer() const noexcept -> ValueType { return load(); }
+
+    //! Store a new value.
+    auto store(ValueType const & new_value) noexcept -> stored_type
+    {
+        words_type copy { };
+        std::memcpy(&copy, &new_value, sizeof(ValueType));
+
+        auto const sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for(std::size_t i = 0; i < word_count; ++i)
+            words_[i].store(copy.w[i], std::memory_order_relaxed);
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+        return new_value;
+    }
+
+    //! Return the value held by a stored_type.
+    static auto unwrap(stored_type const & v) noexcept -> ValueType const & { return v; }
+
+private:
+    std::atomic<std::size_t> sequence_ { 0 };
+    std::atomic<word> words_[word_count];
+};
+
+//! Storage for any copyable value, kept as an immutable snapshot.
+//!
+//! Snapshots are kept in a few slots, one of which is current. A reader marks
+//! the current slot as being read, checks that it is still current, and copies
+//! the value or the snapshot out of it. A writer fills a slot that is neither
+//! current nor being read, then makes it current, so readers never wait for a
+//! writer; a writer waits only if every other slot is being read.
+//!
+//! \warning Only one store() can run at a time.
+//! \ingroup observable_detail
+template <typename ValueType>
+class snapshot_storage final
+{
+    static constexpr std::size_t slot_count = 4;
+
+    struct alignas(64) slot
+    {
+        mutable std::atomic<std::size_t> readers { 0 };
+        snapshot<ValueType> value;
+    };
+
+    struct read_guard
+    {
+        std::atomic<std::size_t> & readers;
+        ~read_guard() { readers.fetch_sub(1, std::memory_order_release); }
+    };
+
+public:
+    //! Value returned by store().
+    using stored_type = snapshot<ValueType>;
+
+    explicit snapshot_storage(ValueType initial_value)
+    {
+        slots_[0].value = std::make_shared<ValueType const>(std::move(initial_value));
+    }
+
+    //! Return the current snapshot. Never blocks.
+    auto load_snapshot() const -> stored_type
+    {
+        return read([](auto const & v) { return v; });
+    }
+
+    //! Return a copy of the stored value. Never blocks.
+    auto load() const -> ValueType
+    {
+        return read([](auto const & v) { return *v; });
+    }
+
+    //! Return the stored value, as seen by the writer, without copying it.
+    //! Only call it while no store() can run.
+    //!
+    //! Only store() replaces the value of a slot, so the current slot can be
+    //! read without marking it as being read.
+    auto load_for_writer() const noexcept -> ValueType const &
+    {
+        return *slots_[current_.load(std::memory_order_relaxed)].value;
+    }
+
+    //! Store a new value.
+    auto store(ValueType && new_value) -> stored_type
+    {
+        auto next = std::make_shared<ValueType const>(std::move(new_value));
+        auto const previous = current_.load(std::memory_order_relaxed);
+
+        for(;;)
+        {
+            for(std::size_t i = 0; i < slot_count; ++i)
+            {
+                if(i == previous || slots_[i].readers.load() != 0)
+                    continue;
+
+                slots_[i].value = next;
+                current_.store(i);
+
+                // Do not keep the old value alive longer than needed.
+                if(slots_[previous].readers.load() == 0)
+                    slots_[previous].value.reset();
+
+                return next;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    //! Return the value held by a stored_type.
+    static auto unwrap(stored_type const & v) noexcept -> ValueType const & { return *v; }
+
+private:
+    template <typename Reader>
+    auto read(Reader && reader) const
+    {
+        for(;;)
+        {
+            auto const index = current_.load();
+            auto & s = slots_[index];
+
+            s.readers.fetch_add(1);
+            read_guard const guard { s.readers };
+
+            if(current_.load() == index)
+                return reader(s.value);
+        }
+    }
+
+private:
+    slot slots_[slot_count];
+    std::atomic<std::size_t> current_ { 0 };
+};
+
+}
+
+//! Observable value that can be read and written from multiple threads.
+//!
+//! Readers never block: get() does not take any lock and is not slowed down
+//! by writers or by other readers. Writers are serialized with a mutex, and
+//! each set() that changes the value notifies the subscribed observers exactly
+//! once, on the writer's thread, after the new value is visible to readers.
+//!
+//! Trivially copyable values are kept behind a sequence lock; readers copy the
+//! value and retry if a write was in progress. Other values are kept as
+//! immutable snapshots, published by switching between a few slots; readers
+//! can also retrieve the snapshot itself, with get_snapshot(), to avoid copying
+//! the value.
+//!
+//! Unlike value<ValueType>, concurrent values cannot be used in expressions.
+//!
+//! All methods can be safely called in parallel, from multiple threads.
+//!
+//! \warning Observers are called without holding any lock, so observers of two
+//!          concurrent set() calls can run in parallel, and in any order.
+//!
+//! \tparam ValueType The value-type that will be stored inside the observable.
+//!                   This type must be copy constructible.
+//!
+//! \ingroup observable
+template <typename ValueType>
+class concurrent_value final
+{
+    using void_subject = subject<void()>;
+    using value_subject = subject<void(ValueType const &)>;
+    using storage_type = std::conditional_t<std::is_trivially_copyable<ValueType>::value,
+                                            detail::seqlock_storage<ValueType>,
+                                            detail::snapshot_storage<ValueType>>;
+
+public:
+    //! The observable value's stored value type.
+    using value_type = ValueType;
+
+    //! Create a default-constructed concurrent value.
+    concurrent_value() : concurrent_value(ValueType { }) { }
+
+    //! Create an initialized concurrent value.
+    //!
+    //! \param initial_value The observable's initial value.
+    explicit concurrent_value(ValueType initial_value) :
+        storage_ { std::move(initial_value) }
+    { }
+
+    //! Create an initialized concurrent value.
+    //!
+    //! \param initial_value The observable's initial value.
+    //! \param equal A functor to be used for comparing values. The functor must
+    //!              have a signature compatible with the one below:
+    //!
+    //!                 bool(ValueType const &, ValueType const &)
+    //!
+    //!              The comparator must return true if both of its parameters
+    //!              are equal.
+    template <typename EqualityComparator>
+    concurrent_value(ValueType initial_value, EqualityComparator equal) :
+        storage_ { std::move(initial_value) },
+        eq_ { std::move(equal) }
+    { }
+
+    //! Retrieve a copy of the stored value. Never blocks.
+    auto get() const -> ValueType { return storage_.load(); }
+
+    //! Retrieve the current snapshot of the stored value, without copying it.
+    //!
+    //! The snapshot stays valid, and unchanged, after the value has been set
+    //! again. Only available for values that are not trivially copyable.
+    template <typename S = storage_type>
+    auto get_snapshot() const -> decltype(std::declval<S const &>().load_snapshot())
+    {
+        return storage_.load_snapshot();
+    }
+
+    //! Subscribe to changes to the concurrent value.
+    //!
+    //! \param[in] observer A callable that will be called whenever the value
+    //!                     changes. The observer must satisfy the Callable
+    //!                     concept.
+    //!
+    //! \tparam Callable A callable taking no parameters or a callable taking one
+    //!                  parameter that will be called with the new value.
+    //!
+    //! \see value<ValueType>::subscribe()
+    template <typename Callable>
+    auto subscribe(Callable && observer) const
+    {
+        static_assert(detail::is_compatible_with_subject<Callable, void_subject>::value ||
+                      detail::is_compatible_with_subject<Callable, value_subject>::value,
+                      "Observer is not valid. Please provide a void observer or an "
+                      "observer that takes a ValueType as its only argument.");
+
+        return subscribe_impl(std::forward<Callable>(observer));
+    }
+
+    //! Set a new value, notifying any subscribed observers if the new value is
+    //! different from the existing one.
+    //!
+    //! \param new_value The new value to set.
+    void set(ValueType new_value)
+    {
+        std::unique_lock<std::mutex> lock { write_mutex_ };
+
+        if(eq_(storage_.load_for_writer(), new_value))
+            return;
+
+        auto const stored = storage_.store(std::move(new_value));
+        lock.unlock();
+
+        void_observers_.notify();
+        value_observers_.notify(storage_type::unwrap(stored));
+    }
+
+    //! Set a new value. Will just call set(ValueType).
+    //!
+    //! \see set(ValueType)
+    auto operator=(ValueType new_value) -> concurrent_value &
+    {
+        set(std::move(new_value));
+        return *this;
+    }
+
+public:
+    //! Concurrent values are not copy-constructible.
+    concurrent_value(concurrent_value const &) =delete;
+
+    //! Concurrent values are not copy-assignable.
+    auto operator=(concurrent_value const &) -> concurrent_value & =delete;
+
+    //! Concurrent values are not move-constructible.
+    concurrent_value(concurrent_value &&) =delete;
+
+    //! Concurrent values are not move-assignable.
+    auto operator=(concurrent_value &&) -> concurrent_value & =delete;
+
+private:
+    template <typename Callable>
+    auto subscribe_impl(Callable && observer) const ->
+        std::enable_if_t<detail::is_compatible_with_subject<Callable, void_subject>::value &&
+                         !detail::is_compatible_with_subject<Callable, value_subject>::value,
+                         infinite_subscription>
+    {
+        return void_observers_.subscribe(std::forward<Callable>(observer));
+    }
+
+    template <typename Callable>
+    auto subscribe_impl(Callable && observer) const ->
+        std::enable_if_t<detail::is_compatible_with_subject<Callable,
+                                                            value_subject>::value,
+                         infinite_subscription>
+    {
+        return value_observers_.subscribe(std::forward<Callable>(observer));
+    }
+
+private:
+    storage_type storage_;
+    std::mutex write_mutex_;
+
+    std::function<bool(ValueType const &, ValueType const &)> eq_ {
+        [](auto && a, auto && b) { return detail::equal_to { }(a, b); }
+    };
+
+    mutable void_subject void_observers_;
+    mutable value_subject value_observers_;
+};
+
+}
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
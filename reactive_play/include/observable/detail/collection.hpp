@@ -1,6 +1,10 @@
 #pragma once
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <observable/detail/compiler_config.hpp>
 OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
@@ -46,19 +50,16 @@ public:
     auto insert(ValueType_ && element)
     {
         auto const i = ++last_id_;
-        auto n = std::make_unique<node>();
-        n->node_id = i;
-        n->element = std::forward<ValueType_>(element);
+        auto n = std::make_unique<node>(i, std::forward<ValueType_>(element));
 
-        {
-            auto const block_gc = gc_blocker { this };
-
-            n->next = head_.load();
-            while(!head_.compare_exchange_weak(n->next, n.get()))
-                ;
+        // Nodes are only dereferenced by readers, so pushing a new head does
+        // not need to enter an epoch.
+        auto head = head_.load();
+        do
+            n->next.store(head);
+        while(!head_.compare_exchange_weak(head, n.get()));
 
-            n.release();
-        }
+        n.release();
 
         gc();
         return i;
@@ -81,9 +82,9 @@ public:
     {
         auto deleted = false;
         {
-            auto const block_gc = gc_blocker { this };
+            auto const guard = read_guard { this };
 
-            for(auto n = head_.load(); n; n = n->next)
+            for(auto n = head_.load(); n; n = n->next.load())
             {
                 if(n->node_id != element_id)
                     continue;
@@ -108,6 +109,9 @@ public:
     //! \note It is well defined and supported to remove() the element passed
     //!       to the functor, even before the functor returns.
     //!
+    //! \note This method never waits for other threads; it does not spin or
+    //!       take any locks.
+    //!
     //! \param[in] fun A functor that will be called with each element of the
     //!                collection. The functor must be assignable to a
     //!                ``std::function<void(ValueType const &)>``.
@@ -117,9 +121,9 @@ public:
     void apply(UnaryFunctor && fun) const
         noexcept(noexcept(fun(std::declval<ValueType>())))
     {
-        auto const block_gc = gc_blocker { this };
+        auto const guard = read_guard { this };
 
-        for(auto n = head_.load(); n; n = n->next)
+        for(auto n = head_.load(); n; n = n->next.load())
         {
             if(n->deleted.load())
                 continue;
@@ -128,10 +132,22 @@ public:
         }
     }
 
+    //! Return a copy of all elements of the collection.
+    //!
+    //! The returned elements can be used after the collection has been
+    //! modified or destroyed.
+    auto view() const
+    {
+        auto elements = std::make_shared<std::vector<ValueType>>();
+        apply([&](auto const & e) { elements->push_back(e); });
+
+        return std::shared_ptr<std::vector<ValueType> const> { std::move(elements) };
+    }
+
     //! Return true if the collection has no elements.
     auto empty() const noexcept
     {
-        auto const block_gc = gc_blocker { this };
+        auto const guard = read_guard { this };
         auto const h = head_.load();
         return !h || h->deleted;
     }
@@ -139,10 +155,11 @@ public:
     //! Destructor.
     ~collection() noexcept
     {
-        for(auto n = head_.load(); n; n = n->next)
-            n->deleted.store(true);
+        for(auto n = head_.load(); n;)
+            delete std::exchange(n, n->next.load());
 
-        gc();
+        for(auto & r : retired_)
+            delete_retired(r);
     }
 
 public:
@@ -159,72 +176,130 @@ public:
     auto operator=(collection &&) -> collection & =delete;
 
 private:
-    //! Delete any nodes marked as deleted.
+    //! Node data.
+    struct node
+    {
+        template <typename ValueType_>
+        node(id const & i, ValueType_ && e) :
+            element { std::forward<ValueType_>(e) },
+            node_id { i }
+        { }
+
+        std::atomic<node *> next { nullptr };
+        node * next_retired { nullptr };
+        ValueType element;
+        std::atomic<bool> deleted { false };
+        id node_id;
+    };
+
+    //! Unlink nodes marked as deleted and free the ones no reader can reach.
+    //!
+    //! Readers register with the parity of the epoch they have seen. A node
+    //! that was unlinked during epoch E can only be reached by readers that
+    //! entered before it was unlinked, so it is freed once the epoch has been
+    //! advanced twice. The epoch is advanced only when no reader is registered
+    //! with the previous parity; new readers always register with the current
+    //! one, so the previous parity drains even under continuous apply() calls.
+    //!
+    //! Only one thread runs this at a time. Other threads skip it instead of
+    //! waiting, because the running one will collect their nodes too.
     void gc() noexcept
     {
-        if(block_gc_.load() > 0 || gc_active_.exchange(true))
+        std::unique_lock<std::mutex> const lock { gc_mutex_, std::try_to_lock };
+        if(!lock.owns_lock())
             return;
 
+        auto const epoch = epoch_.load();
+        unlink_deleted(retired_[epoch % 3]);
+
+        for(auto e = epoch; e < epoch + 2; ++e)
+        {
+            if(readers_[(e + 1) % 2].load() > 0)
+                break;
+
+            // Nodes unlinked during e - 1 are now unreachable.
+            epoch_.store(e + 1);
+            delete_retired(std::exchange(retired_[(e + 2) % 3], nullptr));
+        }
+    }
+
+    //! Move all nodes marked as deleted from the list to the retired list.
+    void unlink_deleted(node * & retired) noexcept
+    {
         auto head = head_.load();
-        for(auto p = &head; *p && block_gc_ == 0;)
+
+        // Inserts can replace the head at any time, so it is only unlinked if
+        // nothing was pushed in front of it.
+        while(head && head->deleted.load())
         {
-            if(!(*p)->deleted.load())
+            auto const next = head->next.load();
+            if(!head_.compare_exchange_strong(head, next))
+                break;
+
+            head->next_retired = retired;
+            retired = head;
+            head = next;
+        }
+
+        // Next pointers after the head are only modified here.
+        for(auto prev = head_.load(); prev;)
+        {
+            auto const n = prev->next.load();
+            if(!n)
+                break;
+
+            if(!n->deleted.load())
             {
-                p = &((*p)->next);
+                prev = n;
                 continue;
             }
 
-            auto d = *p;
-            *p = (*p)->next;
-            delete d;
-
-            if(p == &head)
-                head_.store(*p);
+            // Readers standing on n can still follow its next pointer, so it
+            // is left untouched.
+            prev->next.store(n->next.load());
+            n->next_retired = retired;
+            retired = n;
         }
+    }
 
-        gc_active_.store(false);
+    //! Delete a chain of retired nodes.
+    static void delete_retired(node * n) noexcept
+    {
+        while(n)
+            delete std::exchange(n, n->next_retired);
     }
 
-    //! Block the gc() method from running for the duration of an instance's
-    //! lifetime.
-    struct gc_blocker
+    //! Register a reader with the current epoch for the duration of an
+    //! instance's lifetime.
+    struct read_guard
     {
-        explicit gc_blocker(collection<ValueType> const * c) noexcept :
-            collection_{ c }
+        explicit read_guard(collection<ValueType> const * c) noexcept :
+            collection_{ c },
+            parity_{ c->epoch_.load() % 2 }
         {
-            ++collection_->block_gc_;
-            while(collection_->gc_active_.load())
-                ;
+            ++collection_->readers_[parity_];
         }
 
-        ~gc_blocker() noexcept
+        ~read_guard() noexcept
         {
-            --collection_->block_gc_;
+            --collection_->readers_[parity_];
         }
 
-        gc_blocker() =delete;
-        gc_blocker(gc_blocker const &) =delete;
-        auto operator=(gc_blocker const &) -> gc_blocker & =delete;
-        gc_blocker(gc_blocker &&) =default;
-        auto operator=(gc_blocker &&) -> gc_blocker & =default;
+        read_guard() =delete;
+        read_guard(read_guard const &) =delete;
+        auto operator=(read_guard const &) -> read_guard & =delete;
 
     private:
         collection<ValueType> const * collection_;
-    };
-
-    //! Node data.
-    struct node
-    {
-        node * next { nullptr };
-        ValueType element;
-        std::atomic<bool> deleted { false };
-        id node_id;
+        std::size_t parity_;
     };
 
 private:
     std::atomic<node *> head_ { nullptr };
-    mutable std::atomic<std::size_t> block_gc_ { 0 };
-    std::atomic<bool> gc_active_ { false };
+    std::atomic<std::size_t> epoch_ { 0 };
+    mutable std::atomic<std::size_t> readers_[2] { { 0 }, { 0 } };
+    node * retired_[3] { nullptr, nullptr, nullptr };
+    std::mutex gc_mutex_;
     std::atomic<id> last_id_ { 0 };
 };
 
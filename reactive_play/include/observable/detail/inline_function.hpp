@@ -0,0 +1,165 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { namespace detail {
+
+//! \cond
+template <typename FunctionType, std::size_t Capacity>
+class inline_function;
+//! \endcond
+
+//! Type-erased callable that is always stored inside the wrapper itself.
+//!
+//! Works like a ``std::function<void(Args ...)>`` that never allocates: any
+//! callable whose size fits in ``Capacity`` bytes is copied into an internal
+//! buffer, and larger callables are rejected at compile time.
+//!
+//! \tparam Args Arguments of the stored callables.
+//! \tparam Capacity Maximum size, in bytes, of the stored callables.
+//! \ingroup observable_detail
+template <typename ... Args, std::size_t Capacity>
+class inline_function<void(Args ...), Capacity> final
+{
+public:
+    //! Create an empty function. Calling it does nothing.
+    inline_function() noexcept =default;
+
+    //! Create a function that stores a copy of the provided callable.
+    //!
+    //! \param[in] callable Callable to store.
+    //! \tparam Callable Type of the callable. Its size must not exceed
+    //!                  ``Capacity``, it must be copy constructible and it
+    //!                  must not throw when moved.
+    template <typename Callable,
+              typename F = std::decay_t<Callable>,
+              typename = std::enable_if_t<!std::is_same<F, inline_function>::value>>
+    inline_function(Callable && callable) :
+        invoke_ { &invoke<F> },
+        manage_ { &manage<F> }
+    {
+        static_assert(sizeof(F) <= Capacity,
+                      "The callable does not fit into the inline_function; increase"
+                      " its Capacity");
+        static_assert(alignof(F) <= alignof(std::max_align_t),
+                      "The callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible<F>::value,
+                      "The callable must be nothrow move constructible");
+
+        ::new (static_cast<void *>(&storage_)) F(std::forward<Callable>(callable));
+    }
+
+    //! Call the stored callable.
+    void operator()(Args ... arguments) const
+    {
+        if(invoke_)
+            invoke_(&storage_, arguments ...);
+    }
+
+    //! Return true if a callable is stored.
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+    //! Destructor.
+    ~inline_function() noexcept { reset(); }
+
+public:
+    //! Functions are copy-constructible.
+    inline_function(inline_function const & other) :
+        invoke_ { other.invoke_ },
+        manage_ { other.manage_ }
+    {
+        if(manage_)
+            manage_(operation::copy, &storage_, &other.storage_);
+    }
+
+    //! Functions are copy-assignable.
+    auto operator=(inline_function const & other) -> inline_function &
+    {
+        if(this != &other)
+        {
+            reset();
+
+            if(other.manage_)
+                other.manage_(operation::copy, &storage_, &other.storage_);
+
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+        }
+
+        return *this;
+    }
+
+    //! Functions are move-constructible. The other function is left empty.
+    inline_function(inline_function && other) noexcept :
+        invoke_ { other.invoke_ },
+        manage_ { other.manage_ }
+    {
+        if(manage_)
+            manage_(operation::move, &storage_, &other.storage_);
+
+        other.reset();
+    }
+
+    //! Functions are move-assignable. The other function is left empty.
+    auto operator=(inline_function && other) noexcept -> inline_function &
+    {
+        if(this != &other)
+        {
+            reset();
+
+            if(other.manage_)
+                other.manage_(operation::move, &storage_, &other.storage_);
+
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            other.reset();
+        }
+
+        return *this;
+    }
+
+private:
+    enum class operation { copy, move, destroy };
+
+    using storage_type = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+    template <typename F>
+    static void invoke(void const * storage, Args ... arguments)
+    {
+        (*static_cast<F *>(const_cast<void *>(storage)))(arguments ...);
+    }
+
+    template <typename F>
+    static void manage(operation op, void * storage, void const * other)
+    {
+        if(op == operation::copy)
+            ::new (storage) F(*static_cast<F const *>(other));
+        else if(op == operation::move)
+            ::new (storage) F(std::move(*static_cast<F *>(const_cast<void *>(other))));
+        else
+            static_cast<F *>(storage)->~F();
+    }
+
+    void reset() noexcept
+    {
+        if(manage_)
+            manage_(operation::destroy, &storage_, nullptr);
+
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+private:
+    void (*invoke_)(void const *, Args ...) { nullptr };
+    void (*manage_)(operation, void *, void const *) { nullptr };
+    storage_type storage_;
+};
+
+} }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
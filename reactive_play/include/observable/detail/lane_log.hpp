@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { namespace detail {
+
+//! Record of the lanes that changed in the last update of an array.
+//!
+//! Every update increments the version. Updates that only changed some lanes
+//! list them, so anyone that saw the previous version can copy or recompute
+//! just those lanes instead of the whole array.
+//!
+//! \ingroup observable_detail
+struct lane_log final
+{
+    //! Version of the array. Zero is never used, so it can stand for an array
+    //! that was never seen.
+    std::size_t version = 1;
+
+    //! True if any lane might have changed in the last update.
+    bool all = true;
+
+    //! Lanes changed by the last update, if not all of them.
+    std::vector<std::size_t> changed;
+
+    //! Record an update that might have changed any lane.
+    void update_all() noexcept
+    {
+        ++version;
+        all = true;
+        changed.clear();
+    }
+
+    //! Record an update that only changed the provided lanes.
+    void update(std::vector<std::size_t> lanes) noexcept
+    {
+        ++version;
+        all = false;
+        changed = std::move(lanes);
+    }
+
+    //! Return true if only the listed lanes changed since version ``seen``.
+    auto partial_since(std::size_t seen) const noexcept
+    {
+        return !all && seen != 0 && version == seen + 1;
+    }
+};
+
+//! Lane record of types that are not arrays. It records nothing.
+//!
+//! \ingroup observable_detail
+struct no_lane_log final
+{
+    void update_all() noexcept { }
+};
+
+//! \cond
+template <typename T>
+struct lane_log_ { using type = no_lane_log; };
+
+template <typename T, typename A>
+struct lane_log_<std::vector<T, A>> { using type = lane_log; };
+//! \endcond
+
+//! Lane record kept for values of type ``T``: a lane_log for arrays, else a
+//! no_lane_log.
+//!
+//! \ingroup observable_detail
+template <typename T>
+using lane_log_t = typename lane_log_<T>::type;
+
+//! Check if values of type ``T`` are arrays that keep a lane_log.
+//!
+//! \ingroup observable_detail
+template <typename T>
+using has_lanes = std::is_same<lane_log_t<T>, lane_log>;
+
+//! Copy an array into another, copying only the lanes that changed since the
+//! destination was last updated from it.
+//!
+//! \param[in,out] to Destination array.
+//! \param[in,out] to_log Lane record of the destination, updated with the lanes
+//!                       that were copied.
+//! \param[in] from Source array.
+//! \param[in] from_log Lane record of the source.
+//! \param[in,out] seen Version of the source that was last copied.
+//!
+//! \ingroup observable_detail
+template <typename T, typename A>
+inline void assign_lanes(std::vector<T, A> & to, lane_log & to_log,
+                         std::vector<T, A> const & from, lane_log const & from_log,
+                         std::size_t & seen)
+{
+    if(from_log.partial_since(seen) && to.size() == from.size())
+    {
+        for(auto i : from_log.changed)
+            to[i] = from[i];
+
+        to_log.update(from_log.changed);
+    }
+    else
+    {
+        to = from;
+        to_log.update_all();
+    }
+
+    seen = from_log.version;
+}
+
+//! Copy a value that is not an array.
+//!
+//! \ingroup observable_detail
+template <typename To, typename ToLog, typename From, typename FromLog>
+inline void assign_lanes(To & to, ToLog & to_log, From const & from, FromLog const &, std::size_t &)
+{
+    to = from;
+    to_log.update_all();
+}
+
+} }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { namespace detail { namespace simd {
+
+//! Group of lanes that are processed by a single instruction.
+//!
+//! The primary template is used for types that have no vector instructions; its
+//! width is zero and it has no operations. Specializations exist for ``float``
+//! and ``double`` when compiling for AVX (8 and 4 lanes) or SSE2 (4 and 2
+//! lanes). Compile with ``-mavx`` or ``/arch:AVX`` to use the wider packs.
+//!
+//! Specializations provide ``load()``, ``broadcast()``, ``store()``, ``add()``,
+//! ``sub()``, ``mul()``, ``div()``, ``min()``, ``max()``, ``sqrt()`` and
+//! ``abs()``. Loads and stores do not need aligned pointers.
+//!
+//! \ingroup observable_detail
+template <typename T>
+struct pack
+{
+    static constexpr std::size_t width = 0;
+};
+
+#if defined(__AVX__)
+
+template <>
+struct pack<float>
+{
+    using type = __m256;
+    static constexpr std::size_t width = 8;
+
+    static auto load(float const * p) noexcept { return _mm256_loadu_ps(p); }
+    static auto broadcast(float v) noexcept { return _mm256_set1_ps(v); }
+    static void store(float * p, type v) noexcept { _mm256_storeu_ps(p, v); }
+
+    static auto add(type a, type b) noexcept { return _mm256_add_ps(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm256_sub_ps(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm256_mul_ps(a, b); }
+    static auto div(type a, type b) noexcept { return _mm256_div_ps(a, b); }
+    static auto min(type a, type b) noexcept { return _mm256_min_ps(b, a); }
+    static auto max(type a, type b) noexcept { return _mm256_max_ps(b, a); }
+    static auto sqrt(type a) noexcept { return _mm256_sqrt_ps(a); }
+    static auto abs(type a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+};
+
+template <>
+struct pack<double>
+{
+    using type = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static auto load(double const * p) noexcept { return _mm256_loadu_pd(p); }
+    static auto broadcast(double v) noexcept { return _mm256_set1_pd(v); }
+    static void store(double * p, type v) noexcept { _mm256_storeu_pd(p, v); }
+
+    static auto add(type a, type b) noexcept { return _mm256_add_pd(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm256_sub_pd(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm256_mul_pd(a, b); }
+    static auto div(type a, type b) noexcept { return _mm256_div_pd(a, b); }
+    static auto min(type a, type b) noexcept { return _mm256_min_pd(b, a); }
+    static auto max(type a, type b) noexcept { return _mm256_max_pd(b, a); }
+    static auto sqrt(type a) noexcept { return _mm256_sqrt_pd(a); }
+    static auto abs(type a) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+template <>
+struct pack<float>
+{
+    using type = __m128;
+    static constexpr std::size_t width = 4;
+
+    static auto load(float const * p) noexcept { return _mm_loadu_ps(p); }
+    static auto broadcast(float v) noexcept { return _mm_set1_ps(v); }
+    static void store(float * p, type v) noexcept { _mm_storeu_ps(p, v); }
+
+    static auto add(type a, type b) noexcept { return _mm_add_ps(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm_sub_ps(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm_mul_ps(a, b); }
+    static auto div(type a, type b) noexcept { return _mm_div_ps(a, b); }
+    static auto min(type a, type b) noexcept { return _mm_min_ps(b, a); }
+    static auto max(type a, type b) noexcept { return _mm_max_ps(b, a); }
+    static auto sqrt(type a) noexcept { return _mm_sqrt_ps(a); }
+    static auto abs(type a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+};
+
+template <>
+struct pack<double>
+{
+    using type = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static auto load(double const * p) noexcept { return _mm_loadu_pd(p); }
+    static auto broadcast(double v) noexcept { return _mm_set1_pd(v); }
+    static void store(double * p, type v) noexcept { _mm_storeu_pd(p, v); }
+
+    static auto add(type a, type b) noexcept { return _mm_add_pd(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm_sub_pd(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm_mul_pd(a, b); }
+    static auto div(type a, type b) noexcept { return _mm_div_pd(a, b); }
+    static auto min(type a, type b) noexcept { return _mm_min_pd(b, a); }
+    static auto max(type a, type b) noexcept { return _mm_max_pd(b, a); }
+    static auto sqrt(type a) noexcept { return _mm_sqrt_pd(a); }
+    static auto abs(type a) noexcept { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+};
+
+#endif
+
+} } }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
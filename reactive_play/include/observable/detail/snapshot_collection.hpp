@@ -0,0 +1,306 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { namespace detail {
+
+//! Thread-safe collection that keeps its elements in a contiguous, immutable
+//! snapshot and applies a functor over them.
+//!
+//! Every insert() and remove() copies the current snapshot, modifies the copy
+//! and atomically publishes a pointer to it. An apply() call registers with the
+//! current epoch, loads the snapshot that is current when it starts and then
+//! scans a packed array; it does not take any locks or touch reference counts.
+//! Replaced snapshots are freed by later insert() and remove() calls, once no
+//! apply() that could have loaded them is still running, like the nodes of
+//! \ref collection.
+//!
+//! This makes apply() cheaper than with \ref collection, at the cost of an
+//! insert() and remove() that are linear in the number of elements.
+//!
+//! All methods of the collection can be safely called in parallel, from multiple
+//! threads.
+//!
+//! \warning The order of elements inside the collection is unspecified.
+//!
+//! \tparam ValueType Type of the elements that will be stored inside the
+//!                   collection. This type must be copy constructible.
+//! \ingroup observable_detail
+template <typename ValueType>
+class snapshot_collection final
+{
+public:
+    //! Identifier for an element that has been inserted. You can use this id to
+    //! remove a previously inserted element.
+    using id = std::size_t;
+
+    //! Create an empty collection.
+    snapshot_collection() =default;
+
+    //! Insert a new element into the collection.
+    //!
+    //! \param[in] element The object to be inserted.
+    //! \tparam ValueType_ Type of the inserted element. Must be convertible to
+    //!                    the collection's ValueType.
+    //!
+    //! \return An \ref id that can be used to remove the inserted element.
+    //!         This \ref id is stable; you can use it after modifying the
+    //!         collection.
+    //!
+    //! \note Any apply() call running concurrently with an insert() is
+    //!       guaranteed to not call the functor for the newly inserted element.
+    template <typename ValueType_>
+    auto insert(ValueType_ && element)
+    {
+        std::lock_guard<std::mutex> const lock { write_mutex_ };
+
+        auto next = std::make_shared<snapshot>();
+        next->entries.reserve(current_->entries.size() + 1);
+
+        for(auto const & e : current_->entries)
+            next->entries.push_back(e);
+
+        // Ids are handed out under the lock, so entries stay sorted by id.
+        auto const i = ++last_id_;
+        next->entries.push_back(entry { i, std::forward<ValueType_>(element) });
+
+        publish(std::move(next));
+        return i;
+    }
+
+    //! Remove a previously inserted element from the collection.
+    //!
+    //! If no element with the provided \ref id exists, this method does nothing.
+    //!
+    //! \param[in] element_id Id of the element to remove. This is returned by
+    //!                       insert.
+    //!
+    //! \return True if an element of the collection was removed, false if no
+    //!         element has been removed.
+    //!
+    //! \note Any apply() call running concurrently with a remove() call that has
+    //!       not already called its functor with the removed element, is
+    //!       guaranteed to not call the functor with the removed element.
+    auto remove(id const & element_id)
+    {
+        std::lock_guard<std::mutex> const lock { write_mutex_ };
+
+        auto const & entries = current_->entries;
+        auto const it = current_->find(element_id);
+        if(it == entries.end())
+            return false;
+
+        auto next = std::make_shared<snapshot>();
+        next->entries.reserve(entries.size() - 1);
+
+        for(auto const & e : entries)
+            if(e.entry_id != element_id)
+                next->entries.push_back(e);
+
+        publish(std::move(next));
+
+        // Running apply() calls see this and check their remaining elements
+        // against the new snapshot.
+        removals_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    //! Apply a unary functor over all elements of the collection.
+    //!
+    //! The functor will be called multiple times, with each element, in an
+    //! unspecified order.
+    //!
+    //! \note This method is reentrant; you can call insert() and remove() on the
+    //!       collection from inside the functor.
+    //!
+    //! \note It is well defined and supported to remove() the element passed
+    //!       to the functor, even before the functor returns.
+    //!
+    //! \note This method never waits for other threads; it does not spin or
+    //!       take any locks.
+    //!
+    //! \param[in] fun A functor that will be called with each element of the
+    //!                collection. The functor must be assignable to a
+    //!                ``std::function<void(ValueType const &)>``.
+    //!
+    //! \tparam UnaryFunctor Type of the ``fun`` parameter.
+    template <typename UnaryFunctor>
+    void apply(UnaryFunctor && fun) const
+        noexcept(noexcept(fun(std::declval<ValueType>())))
+    {
+        auto const guard = read_guard { this };
+
+        // Removals are read first, so a remove() that publishes after the
+        // snapshot is loaded is always noticed.
+        auto seen_removals = removals_.load(std::memory_order_acquire);
+        auto const view = snapshot_.load(std::memory_order_acquire);
+
+        auto it = view->entries.begin();
+        auto const end = view->entries.end();
+
+        for(; it != end && removals_.load(std::memory_order_acquire) == seen_removals; ++it)
+            fun(it->element);
+
+        // Something has been removed during this call, so the remaining
+        // elements are checked against the latest snapshot.
+        snapshot const * current = nullptr;
+
+        for(; it != end; ++it)
+        {
+            auto const removals = removals_.load(std::memory_order_acquire);
+            if(!current || removals != seen_removals)
+            {
+                seen_removals = removals;
+                current = snapshot_.load(std::memory_order_acquire);
+            }
+
+            if(current->find(it->entry_id) == current->entries.end())
+                continue;
+
+            fun(it->element);
+        }
+    }
+
+    //! Return the current snapshot.
+    //!
+    //! The snapshot is immutable and stays valid after the collection has been
+    //! modified or destroyed. Its elements are accessed with ``size()`` and
+    //! ``operator[]``, like a ``std::vector<ValueType>``.
+    auto view() const noexcept
+    {
+        auto const guard = read_guard { this };
+        return snapshot_.load(std::memory_order_acquire)->shared_from_this();
+    }
+
+    //! Return true if the collection has no elements.
+    auto empty() const noexcept
+    {
+        auto const guard = read_guard { this };
+        return snapshot_.load(std::memory_order_acquire)->entries.empty();
+    }
+
+public:
+    //! Collections are not copy-constructible.
+    snapshot_collection(snapshot_collection const &) =delete;
+
+    //! Collections are not copy-assignable.
+    auto operator=(snapshot_collection const &) -> snapshot_collection & =delete;
+
+    //! Collections are not move-constructible.
+    snapshot_collection(snapshot_collection &&) =delete;
+
+    //! Collections are not move-assignable.
+    auto operator=(snapshot_collection &&) -> snapshot_collection & =delete;
+
+private:
+    //! Element data.
+    struct entry
+    {
+        id entry_id;
+        ValueType element;
+    };
+
+    //! Immutable array of elements, sorted by id.
+    struct snapshot : std::enable_shared_from_this<snapshot>
+    {
+        using iterator = typename std::vector<entry>::const_iterator;
+
+        //! Return the number of elements.
+        auto size() const noexcept { return entries.size(); }
+
+        //! Return the element at the provided position.
+        auto operator[](std::size_t i) const noexcept -> ValueType const &
+        {
+            return entries[i].element;
+        }
+
+        //! Return the entry with the provided id, or end.
+        auto find(id const & entry_id) const noexcept -> iterator
+        {
+            auto const it = std::lower_bound(entries.begin(), entries.end(), entry_id,
+                                             [](auto const & e, auto const & i) {
+                                                 return e.entry_id < i;
+                                             });
+
+            return it != entries.end() && it->entry_id == entry_id ? it : entries.end();
+        }
+
+        std::vector<entry> entries;
+    };
+
+    //! Publish a new snapshot and retire the current one. The write mutex
+    //! must be held.
+    void publish(std::shared_ptr<snapshot const> next)
+    {
+        snapshot_.store(next.get(), std::memory_order_release);
+        retired_[epoch_.load() % 3].push_back(std::exchange(current_, std::move(next)));
+        gc();
+    }
+
+    //! Free the retired snapshots no reader can reach.
+    //!
+    //! This follows the epochs of \ref collection: a snapshot retired during
+    //! epoch E is freed once the epoch has been advanced twice, and the epoch
+    //! is only advanced when no reader is registered with the previous parity.
+    //! Snapshots handed out by view() are shared, so they outlive this.
+    void gc() noexcept
+    {
+        auto const epoch = epoch_.load();
+
+        for(auto e = epoch; e < epoch + 2; ++e)
+        {
+            if(readers_[(e + 1) % 2].load() > 0)
+                break;
+
+            // Snapshots retired during e - 1 are now unreachable.
+            epoch_.store(e + 1);
+            retired_[(e + 2) % 3].clear();
+        }
+    }
+
+    //! Register a reader with the current epoch for the duration of an
+    //! instance's lifetime.
+    struct read_guard
+    {
+        explicit read_guard(snapshot_collection<ValueType> const * c) noexcept :
+            collection_{ c },
+            parity_{ c->epoch_.load() % 2 }
+        {
+            ++collection_->readers_[parity_];
+        }
+
+        ~read_guard() noexcept
+        {
+            --collection_->readers_[parity_];
+        }
+
+        read_guard() =delete;
+        read_guard(read_guard const &) =delete;
+        auto operator=(read_guard const &) -> read_guard & =delete;
+
+    private:
+        snapshot_collection<ValueType> const * collection_;
+        std::size_t parity_;
+    };
+
+private:
+    std::shared_ptr<snapshot const> current_ { std::make_shared<snapshot const>() };
+    std::atomic<snapshot const *> snapshot_ { current_.get() };
+    std::atomic<std::size_t> removals_ { 0 };
+    std::atomic<std::size_t> epoch_ { 0 };
+    mutable std::atomic<std::size_t> readers_[2] { { 0 }, { 0 } };
+    std::vector<std::shared_ptr<snapshot const>> retired_[3];
+    std::mutex write_mutex_;
+    id last_id_ { 0 };
+};
+
+} }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
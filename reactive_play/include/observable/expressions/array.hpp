@@ -0,0 +1,365 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <observable/detail/lane_log.hpp>
+#include <observable/detail/simd.hpp>
+#include <observable/expressions/filters.hpp>
+#include <observable/expressions/math.hpp>
+#include <observable/expressions/utility.hpp>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { inline namespace expr {
+
+//! \cond
+namespace filter_detail {
+
+template <typename T>
+struct lane_type { using type = T; };
+
+template <typename T, typename A>
+struct lane_type<std::vector<T, A>> { using type = T; };
+
+template <typename T>
+using lane_type_t = typename lane_type<std::decay_t<T>>::type;
+
+template <typename T>
+inline auto lane_count(T const &) noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+template <typename T, typename A>
+inline auto lane_count(std::vector<T, A> const & v) noexcept { return v.size(); }
+
+template <typename T>
+inline auto lane(T const & v, std::size_t) noexcept -> T const & { return v; }
+
+template <typename T, typename A>
+inline auto lane(std::vector<T, A> const & v, std::size_t i) noexcept -> T const & { return v[i]; }
+
+template <typename P, typename T>
+inline auto load(T const & v, std::size_t) noexcept { return P::broadcast(v); }
+
+template <typename P, typename T, typename A>
+inline auto load(std::vector<T, A> const & v, std::size_t i) noexcept { return P::load(v.data() + i); }
+
+template <typename T>
+inline auto lane_changed(T const & v, T const & old, std::size_t) { return !(v == old); }
+
+template <typename T, typename A>
+inline auto lane_changed(std::vector<T, A> const & v, std::vector<T, A> const & old, std::size_t i)
+{
+    return !(v[i] == old[i]);
+}
+
+template <typename T>
+inline auto scalar_changed(T const & v, T const & old) { return !(v == old); }
+
+template <typename T, typename A>
+inline auto scalar_changed(std::vector<T, A> const &, std::vector<T, A> const &) { return false; }
+
+// Arguments kept by the filters between calls. Scalars are always kept, arrays
+// only by filters that compare lanes to find the ones that changed.
+
+template <typename T, bool Arrays>
+struct kept { using type = T; };
+
+template <typename T, typename A>
+struct kept<std::vector<T, A>, false> { struct type { }; };
+
+template <typename T>
+inline void keep(T & old, T const & v) { old = v; }
+
+template <typename Kept, typename T>
+inline void keep(Kept &, T const &) noexcept { }
+
+template <typename T, typename A>
+inline void keep_lanes(std::vector<T, A> & old, std::vector<T, A> const & v,
+                       std::vector<std::size_t> const & lanes)
+{
+    for(auto i : lanes)
+        old[i] = v[i];
+}
+
+template <typename Kept, typename T>
+inline void keep_lanes(Kept &, T const &, std::vector<std::size_t> const &) noexcept { }
+
+// Add the lanes of an argument that changed since version ``seen`` to
+// ``lanes``. Return false if any lane might have changed.
+
+template <typename T, typename A, typename Kept>
+inline auto changed_lanes(std::vector<T, A> const &, detail::lane_log const & log, Kept const &,
+                          std::size_t seen, std::vector<std::size_t> & lanes)
+{
+    if(log.version == seen)
+        return true;
+
+    if(!log.partial_since(seen))
+        return false;
+
+    lanes.insert(lanes.end(), log.changed.begin(), log.changed.end());
+    return true;
+}
+
+template <typename T>
+inline auto changed_lanes(T const & v, detail::no_lane_log const &, T const & old,
+                          std::size_t, std::vector<std::size_t> &)
+{
+    return !scalar_changed(v, old);
+}
+
+inline auto lane_version(detail::lane_log const & log) noexcept { return log.version; }
+
+inline auto lane_version(detail::no_lane_log const &) noexcept { return std::size_t { 0 }; }
+
+// Vectorized counterparts of the scalar filters.
+
+struct packed_add { template <typename P, typename V> static auto apply(V a, V b) { return P::add(a, b); } };
+struct packed_sub { template <typename P, typename V> static auto apply(V a, V b) { return P::sub(a, b); } };
+struct packed_mul { template <typename P, typename V> static auto apply(V a, V b) { return P::mul(a, b); } };
+struct packed_div { template <typename P, typename V> static auto apply(V a, V b) { return P::div(a, b); } };
+struct packed_sqrt { template <typename P, typename V> static auto apply(V a) { return P::sqrt(a); } };
+struct packed_abs { template <typename P, typename V> static auto apply(V a) { return P::abs(a); } };
+
+struct packed_min
+{
+    template <typename P, typename V, typename ... Rest>
+    static auto apply(V a, Rest ... rest)
+    {
+        for(auto r : { rest ... })
+            a = P::min(a, r);
+
+        return a;
+    }
+};
+
+struct packed_max
+{
+    template <typename P, typename V, typename ... Rest>
+    static auto apply(V a, Rest ... rest)
+    {
+        for(auto r : { rest ... })
+            a = P::max(a, r);
+
+        return a;
+    }
+};
+
+struct packed_clamp
+{
+    template <typename P, typename V>
+    static auto apply(V val, V low, V high) { return P::min(high, P::max(low, val)); }
+};
+
+//! Elementwise version of a scalar filter.
+//!
+//! Arguments can be arrays or scalars; scalars are used for every lane. All
+//! lanes are converted to the common type of the arguments' lane types, and the
+//! result has as many lanes as the shortest array.
+//!
+//! Filters that have a vectorized counterpart (``PackedOp``) process a full
+//! pack of lanes at once when the lane type has one, and the remaining lanes
+//! one at a time.
+//!
+//! Inside an expression, the filter updates its previous result in place. If
+//! the arrays only changed in some lanes, for example through
+//! value::set_lanes(), only those lanes are computed again. Otherwise filters
+//! with a vectorized counterpart compute every lane, and other filters compare
+//! the arguments with the ones of the previous call to find the lanes that
+//! changed.
+template <typename ScalarOp, typename PackedOp = void>
+struct lanes_
+{
+    //! State kept by an expression node between calls to update().
+    template <typename ... Args>
+    struct lane_state
+    {
+        std::tuple<typename kept<Args, std::is_void<PackedOp>::value>::type ...> previous;
+        std::array<std::size_t, sizeof ... (Args)> seen { };
+    };
+
+    template <typename ... Args, typename = std::enable_if_t<expr_detail::are_any_arrays<Args ...>::value>>
+    auto operator()(Args const & ... args) const
+    {
+        using lane_t = std::common_type_t<lane_type_t<Args> ...>;
+        using result_t = std::decay_t<decltype(op_(static_cast<lane_t>(lane(args, 0)) ...))>;
+
+        std::vector<result_t> result;
+        compute(result, args ...);
+        return result;
+    }
+
+    //! Update the previous result of an expression node from its child nodes.
+    template <typename Result, typename State, typename ... Nodes>
+    void update(Result & result, detail::lane_log & log, State & state, Nodes const & ... nodes) const
+    {
+        update(result, log, state, std::index_sequence_for<Nodes ...> { }, nodes ...);
+    }
+
+private:
+    template <typename Result, typename State, std::size_t ... I, typename ... Nodes>
+    void update(Result & result, detail::lane_log & log, State & state,
+                std::index_sequence<I ...> indices, Nodes const & ... nodes) const
+    {
+        using lane_t = std::common_type_t<lane_type_t<decltype(nodes.get())> ...>;
+
+        auto const count = std::min({ lane_count(nodes.get()) ... });
+        auto lanes = std::vector<std::size_t> { };
+
+        auto const partial = result.size() == count &&
+                             (changed_lanes(nodes.get(), nodes.lanes(), std::get<I>(state.previous),
+                                            state.seen[I], lanes) && ...);
+
+        if(partial)
+        {
+            std::sort(lanes.begin(), lanes.end());
+            lanes.erase(std::unique(lanes.begin(), lanes.end()), lanes.end());
+            lanes.erase(std::lower_bound(lanes.begin(), lanes.end(), count), lanes.end());
+
+            for(auto i : lanes)
+                result[i] = op_(static_cast<lane_t>(lane(nodes.get(), i)) ...);
+
+            (keep_lanes(std::get<I>(state.previous), nodes.get(), lanes), ...);
+            log.update(std::move(lanes));
+        }
+        else if constexpr(std::is_void<PackedOp>::value)
+        {
+            if(result.size() == count && !changed(state.previous, indices, nodes.get() ...))
+            {
+                for(auto i = std::size_t { 0 }; i < count; ++i)
+                {
+                    if(lane_changed(state.previous, i, indices, nodes.get() ...))
+                    {
+                        result[i] = op_(static_cast<lane_t>(lane(nodes.get(), i)) ...);
+                        lanes.push_back(i);
+                    }
+                }
+
+                log.update(std::move(lanes));
+            }
+            else
+            {
+                compute(result, nodes.get() ...);
+                log.update_all();
+            }
+
+            (keep(std::get<I>(state.previous), nodes.get()), ...);
+        }
+        else
+        {
+            compute(result, nodes.get() ...);
+            log.update_all();
+            (keep(std::get<I>(state.previous), nodes.get()), ...);
+        }
+
+        ((state.seen[I] = lane_version(nodes.lanes())), ...);
+    }
+
+    //! Compute every lane, reusing the storage of the result.
+    template <typename Result, typename ... Args>
+    void compute(Result & result, Args const & ... args) const
+    {
+        using lane_t = std::common_type_t<lane_type_t<Args> ...>;
+        using result_t = typename Result::value_type;
+        using pack_t = detail::simd::pack<lane_t>;
+
+        auto const count = std::min({ lane_count(args) ... });
+
+        constexpr auto vectorized = !std::is_void<PackedOp>::value && pack_t::width > 0 &&
+                                    std::is_same<result_t, lane_t>::value &&
+                                    std::conjunction<std::is_same<lane_type_t<Args>, lane_t> ...>::value;
+
+        result.resize(count);
+        auto i = std::size_t { 0 };
+
+        if constexpr(vectorized)
+        {
+            for(; i + pack_t::width <= count; i += pack_t::width)
+                pack_t::store(result.data() + i,
+                              PackedOp::template apply<pack_t>(load<pack_t>(args, i) ...));
+        }
+
+        for(; i < count; ++i)
+            result[i] = op_(static_cast<lane_t>(lane(args, i)) ...);
+    }
+
+    //! Return true if a scalar argument changed, or an array argument changed
+    //! size.
+    template <typename Old, std::size_t ... I, typename ... Args>
+    static auto changed(Old const & old, std::index_sequence<I ...>, Args const & ... args)
+    {
+        return ((lane_count(args) != lane_count(std::get<I>(old)) ||
+                 scalar_changed(args, std::get<I>(old))) || ...);
+    }
+
+    template <typename Old, std::size_t ... I, typename ... Args>
+    static auto lane_changed(Old const & old, std::size_t i, std::index_sequence<I ...>, Args const & ... args)
+    {
+        return (filter_detail::lane_changed(args, std::get<I>(old), i) || ...);
+    }
+
+    ScalarOp op_;
+};
+
+}
+//! \endcond
+
+// Elementwise arithmetic operators for arrays.
+
+#define OBSERVABLE_DEFINE_ARRAY_OP(OP, SCALAR_OP, PACKED_OP) \
+template <typename A, typename B> \
+inline auto operator OP (A && a, B && b) \
+    -> std::enable_if_t<expr_detail::are_any_observable<A, B>::value && \
+                        expr_detail::are_any_arrays<A, B>::value, \
+                        expr_detail::result_node_t<filter_detail::lanes_<SCALAR_OP, PACKED_OP>, A, B>> \
+{ \
+    return expr_detail::make_node(filter_detail::lanes_<SCALAR_OP, PACKED_OP> { }, \
+                                  std::forward<A>(a), std::forward<B>(b)); \
+}
+
+OBSERVABLE_DEFINE_ARRAY_OP(+, std::plus<>, filter_detail::packed_add)
+OBSERVABLE_DEFINE_ARRAY_OP(-, std::minus<>, filter_detail::packed_sub)
+OBSERVABLE_DEFINE_ARRAY_OP(*, std::multiplies<>, filter_detail::packed_mul)
+OBSERVABLE_DEFINE_ARRAY_OP(/, std::divides<>, filter_detail::packed_div)
+
+#undef OBSERVABLE_DEFINE_ARRAY_OP
+
+// Elementwise math filters for arrays.
+//
+// These overload the scalar filters, which do not accept arrays.
+
+OBSERVABLE_ADAPT_FILTER(abs, (filter_detail::lanes_<filter_detail::abs_, filter_detail::packed_abs> { }))
+OBSERVABLE_ADAPT_FILTER(sqrt, (filter_detail::lanes_<filter_detail::sqrt_, filter_detail::packed_sqrt> { }))
+OBSERVABLE_ADAPT_FILTER(min, (filter_detail::lanes_<filter_detail::min_, filter_detail::packed_min> { }))
+OBSERVABLE_ADAPT_FILTER(max, (filter_detail::lanes_<filter_detail::max_, filter_detail::packed_max> { }))
+OBSERVABLE_ADAPT_FILTER(clamp, (filter_detail::lanes_<filter_detail::clamp_, filter_detail::packed_clamp> { }))
+
+OBSERVABLE_ADAPT_FILTER(exp, filter_detail::lanes_<filter_detail::exp_> { })
+OBSERVABLE_ADAPT_FILTER(exp2, filter_detail::lanes_<filter_detail::exp2_> { })
+OBSERVABLE_ADAPT_FILTER(log, filter_detail::lanes_<filter_detail::log_> { })
+OBSERVABLE_ADAPT_FILTER(log10, filter_detail::lanes_<filter_detail::log10_> { })
+OBSERVABLE_ADAPT_FILTER(log2, filter_detail::lanes_<filter_detail::log2_> { })
+OBSERVABLE_ADAPT_FILTER(pow, filter_detail::lanes_<filter_detail::pow_> { })
+OBSERVABLE_ADAPT_FILTER(cbrt, filter_detail::lanes_<filter_detail::cbrt_> { })
+OBSERVABLE_ADAPT_FILTER(hypot, filter_detail::lanes_<filter_detail::hypot_> { })
+OBSERVABLE_ADAPT_FILTER(sin, filter_detail::lanes_<filter_detail::sin_> { })
+OBSERVABLE_ADAPT_FILTER(cos, filter_detail::lanes_<filter_detail::cos_> { })
+OBSERVABLE_ADAPT_FILTER(tan, filter_detail::lanes_<filter_detail::tan_> { })
+OBSERVABLE_ADAPT_FILTER(asin, filter_detail::lanes_<filter_detail::asin_> { })
+OBSERVABLE_ADAPT_FILTER(acos, filter_detail::lanes_<filter_detail::acos_> { })
+OBSERVABLE_ADAPT_FILTER(atan, filter_detail::lanes_<filter_detail::atan_> { })
+OBSERVABLE_ADAPT_FILTER(atan2, filter_detail::lanes_<filter_detail::atan2_> { })
+OBSERVABLE_ADAPT_FILTER(ceil, filter_detail::lanes_<filter_detail::ceil_> { })
+OBSERVABLE_ADAPT_FILTER(floor, filter_detail::lanes_<filter_detail::floor_> { })
+OBSERVABLE_ADAPT_FILTER(trunc, filter_detail::lanes_<filter_detail::trunc_> { })
+OBSERVABLE_ADAPT_FILTER(round, filter_detail::lanes_<filter_detail::round_> { })
+
+} }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <observable/batch.hpp>
 #include <observable/subscription.hpp>
 #include <observable/value.hpp>
 #include <observable/expressions/tree.hpp>
@@ -118,20 +119,57 @@ public:
 
     //! Evaluate the expression. This will ensure that the expression's result
     //! is up-to-date.
+    //!
+    //! The result is moved to the updated value, or, if the result is an array
+    //! and only some of its lanes changed, those lanes are copied to it.
+    //! Nothing happens if no input has changed since the last evaluation.
     void eval()
     {
+        if(!root_.dirty())
+            return;
+
         root_.eval();
-        value_notifier_(root_.get());
+
+        if constexpr(detail::has_lanes<ValueType>::value)
+        {
+            auto const & lanes = root_.lanes();
+            auto const partial = lanes_notifier_ && lanes.partial_since(seen_);
+            seen_ = lanes.version;
+
+            if(partial)
+            {
+                lanes_notifier_(root_.get(), lanes.changed);
+                return;
+            }
+        }
+
+        value_notifier_(root_.take());
     }
 
     //! Retrieve the expression's result.
     //!
-    //! \warning If eval() has not been called, the result might be stale.
+    //! \warning If eval() has not been called, the result might be stale. After
+    //!          eval() has been called, the result might have been moved to the
+    //!          updated value.
     virtual auto get() const -> ValueType override { return root_.get(); }
 
+    //! Return one more than the level of the values the expression reads.
+    virtual auto level() const noexcept -> std::size_t override { return root_.level() + 1; }
+
+    //! Return true if an input has changed since the last evaluation.
+    auto dirty() const noexcept { return root_.dirty(); }
+
     virtual void set_value_notifier(std::function<void(ValueType &&)> const & notifier) override
     {
         value_notifier_ = notifier;
+        seen_ = 0;
+    }
+
+    virtual void set_lanes_notifier(
+        std::function<void(ValueType const &, std::vector<std::size_t> const &)> const & notifier) override
+    {
+        lanes_notifier_ = notifier;
+        seen_ = 0;
     }
 
     //! Destructor.
@@ -162,6 +200,8 @@ private:
     EvaluatorType evaluator_;
     typename EvaluatorType::id expression_id_;
     std::function<void(ValueType &&)> value_notifier_ { [](auto &&) { } };
+    std::function<void(ValueType const &, std::vector<std::size_t> const &)> lanes_notifier_;
+    std::size_t seen_ = 0;
 };
 
 //! Evaluator used for expressions that are updated immediately, whenever an
@@ -184,6 +224,9 @@ inline auto get_dummy_evaluator_()
 //! Specialized expression that is updated immediately, whenever an expression
 //! node changes.
 //!
+//! While a \ref batch is open, the expression is evaluated once, when the batch
+//! is committed, instead.
+//!
 //! \see expression<ValueType, EvaluatorType>
 //! \ingroup observable_detail
 template <typename ValueType>
@@ -198,7 +241,19 @@ public:
         expression<ValueType, expression_evaluator>(std::move(root),
                                                     get_dummy_evaluator_())
     {
-        sub = this->root_node().subscribe([&]() { this->eval(); });
+        sub = this->root_node().subscribe([&]() {
+            if(auto const queue = detail::batch_queue::current())
+                queue->push(order_, [this]() { this->eval(); });
+            else
+                this->eval();
+        });
+    }
+
+    //! Destructor.
+    virtual ~expression() override
+    {
+        if(auto const queue = detail::batch_queue::current())
+            queue->remove(order_);
     }
 
 public:
@@ -219,6 +274,7 @@ public:
 
 private:
     unique_subscription sub;
+    std::size_t order_ { detail::batch_queue::next_order() };
 };
 
 } }
@@ -115,7 +115,7 @@ namespace filter_detail {
 
     struct min_
     {
-        template <typename ... Args>
+        template <typename ... Args, typename = expr_detail::enable_if_scalars_t<Args ...>>
         auto operator()(Args && ... args) const
         {
             using std::min;
@@ -125,7 +125,7 @@ namespace filter_detail {
 
     struct max_
     {
-        template <typename ... Args>
+        template <typename ... Args, typename = expr_detail::enable_if_scalars_t<Args ...>>
         auto operator()(Args && ... args) const
         {
             using std::max;
@@ -157,7 +157,8 @@ namespace filter_detail {
 
     struct clamp_
     {
-        template <typename Val, typename Low, typename High>
+        template <typename Val, typename Low, typename High,
+                  typename = expr_detail::enable_if_scalars_t<Val, Low, High>>
         auto operator()(Val && val, Low && low, High && high) const
         {
             using std::min;
@@ -0,0 +1,302 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <observable/subject.hpp>
+#include <observable/subscription.hpp>
+#include <observable/value.hpp>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable { inline namespace expr { namespace expr_detail {
+
+//! Expression tree flattened into a single, contiguous arena.
+//!
+//! A program is built in two phases. First, the nodes of a tree are added, in
+//! post-order, with constant(), load(), load_expression() and op(); each call reserves space in
+//! the arena and returns the offset of the node's result. Then, link()
+//! allocates the arena and constructs all nodes inside it.
+//!
+//! Once linked, run() evaluates the whole tree with one loop over an array of
+//! plain function pointers, each one reading its operands from, and writing its
+//! result to, the arena. There are no ``std::function`` calls and no per-node
+//! heap allocations.
+//!
+//! Subscribers are notified whenever a value read by the program changes.
+//!
+//! \warning None of the methods in this class can be safely called concurrently.
+//! \ingroup observable_detail
+class flat_program final
+{
+public:
+    //! Create an empty program.
+    flat_program() =default;
+
+    //! Add a node that always returns the provided value.
+    //!
+    //! \return Offset of the node's result.
+    template <typename ResultType, typename ValueType>
+    auto constant(ValueType && constant) -> std::size_t
+    {
+        return slot<ResultType>(std::forward<ValueType>(constant));
+    }
+
+    //! Add a node that reads an observable value each time the program is run.
+    //!
+    //! If the value is moved, the node reads the moved-into value. If the value
+    //! is destroyed, the node keeps its last result.
+    //!
+    //! \return Offset of the node's result.
+    template <typename ResultType, typename ValueType, typename ... Rest>
+    auto load(value<ValueType, Rest ...> & source) -> std::size_t
+    {
+        auto const result = slot<ResultType>(source.get());
+        auto const node = reserve<value_load<ResultType, ValueType>>();
+
+        inits_.push_back([this, node, result, s = &source](auto arena) {
+            auto n = ::new (arena + node) value_load<ResultType, ValueType> { s, result };
+            destructors_.emplace_back(&destroy<value_load<ResultType, ValueType>>, node);
+
+            subs_.emplace_back(s->subscribe([this]() { changed_.notify(); }));
+            subs_.emplace_back(s->moved.subscribe([n](auto & v) { n->source = &v; }));
+            subs_.emplace_back(s->destroyed.subscribe([n]() { n->source = nullptr; }));
+        });
+
+        steps_.push_back(step { &value_load<ResultType, ValueType>::run, node });
+        return result;
+    }
+
+    //! Add a node that evaluates another expression node and copies its
+    //! result.
+    //!
+    //! The program keeps a copy of the node, which is evaluated through its own,
+    //! type-erased, eval().
+    //!
+    //! \return Offset of the node's result.
+    template <typename ResultType, typename NodeType>
+    auto load_expression(NodeType const & source) -> std::size_t
+    {
+        auto const result = slot<ResultType>(source.get());
+        auto const node = reserve<expression_load<ResultType, NodeType>>();
+
+        inits_.push_back([this, node, result, source](auto arena) {
+            auto n = ::new (arena + node) expression_load<ResultType, NodeType> { source, result };
+            destructors_.emplace_back(&destroy<expression_load<ResultType, NodeType>>, node);
+
+            subs_.emplace_back(n->source.subscribe([this]() { changed_.notify(); }));
+        });
+
+        steps_.push_back(step { &expression_load<ResultType, NodeType>::run, node });
+        return result;
+    }
+
+    //! Add a node that applies an n-ary operation to the results of previously
+    //! added nodes.
+    //!
+    //! \param[in] op Operation to apply. Must be copy-constructible.
+    //! \param[in] operands Offsets of the nodes whose results will be passed to
+    //!                     the operation.
+    //! \tparam ValueType ... Result types of the operand nodes.
+    //! \return Offset of the node's result.
+    template <typename ResultType, typename ... ValueType, typename OpType, typename ... Offsets>
+    auto op(OpType && op, Offsets ... operands) -> std::size_t
+    {
+        static_assert(sizeof ... (ValueType) == sizeof ... (Offsets),
+                      "Each operand needs a type.");
+
+        using operation_type = operation<ResultType, std::decay_t<OpType>, ValueType ...>;
+
+        auto const result = slot<ResultType>();
+        auto const node = reserve<operation_type>();
+
+        inits_.push_back([this, node, o = std::forward<OpType>(op), result,
+                          args = std::array<std::size_t, sizeof ... (Offsets)> { operands ... }](auto arena) {
+            ::new (arena + node) operation_type { o, result, args };
+            destructors_.emplace_back(&destroy<operation_type>, node);
+        });
+
+        steps_.push_back(step { &operation_type::run, node });
+        return result;
+    }
+
+    //! Allocate the arena and construct all nodes inside it.
+    //!
+    //! After this call, no more nodes can be added.
+    void link()
+    {
+        auto const blocks = (size_ + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        arena_ = std::make_unique<std::max_align_t[]>(blocks);
+
+        for(auto & init : inits_)
+            init(base());
+
+        inits_.clear();
+        inits_.shrink_to_fit();
+    }
+
+    //! Evaluate all nodes, in the order they were added.
+    void run() const
+    {
+        auto const arena = const_cast<flat_program *>(this)->base();
+        for(auto const & s : steps_)
+            s.run(arena, s.node);
+    }
+
+    //! Retrieve the result of a node.
+    //!
+    //! \param[in] offset Offset returned when the node was added.
+    template <typename ResultType>
+    auto get(std::size_t offset) const -> ResultType const &
+    {
+        return *reinterpret_cast<ResultType const *>(
+                    reinterpret_cast<unsigned char const *>(arena_.get()) + offset);
+    }
+
+    //! Subscribe to change notifications from the values read by the program.
+    template <typename Observer>
+    auto subscribe(Observer && observer)
+    {
+        return changed_.subscribe(std::forward<Observer>(observer));
+    }
+
+    //! Return the size, in bytes, of the arena.
+    auto size() const noexcept { return size_; }
+
+    //! Return the number of nodes that are evaluated on each run().
+    auto steps() const noexcept { return steps_.size(); }
+
+    //! Destructor.
+    ~flat_program()
+    {
+        subs_.clear();
+
+        for(auto it = destructors_.rbegin(); it != destructors_.rend(); ++it)
+            it->first(base() + it->second);
+    }
+
+public:
+    //! Programs are not copy-constructible.
+    flat_program(flat_program const &) =delete;
+
+    //! Programs are not copy-assignable.
+    auto operator=(flat_program const &) -> flat_program & =delete;
+
+    //! Programs are not move-constructible.
+    flat_program(flat_program &&) =delete;
+
+    //! Programs are not move-assignable.
+    auto operator=(flat_program &&) -> flat_program & =delete;
+
+private:
+    using byte = unsigned char;
+
+    template <typename T>
+    static auto & at(byte * arena, std::size_t offset) noexcept
+    {
+        return *reinterpret_cast<T *>(arena + offset);
+    }
+
+    template <typename ResultType, typename ValueType>
+    struct value_load
+    {
+        value<ValueType> const * source;
+        std::size_t result;
+
+        static void run(byte * arena, std::size_t offset)
+        {
+            auto const & n = at<value_load>(arena, offset);
+            if(n.source)
+                at<ResultType>(arena, n.result) = n.source->get();
+        }
+    };
+
+    template <typename ResultType, typename NodeType>
+    struct expression_load
+    {
+        NodeType source;
+        std::size_t result;
+
+        static void run(byte * arena, std::size_t offset)
+        {
+            auto & n = at<expression_load>(arena, offset);
+            n.source.eval();
+            at<ResultType>(arena, n.result) = n.source.get();
+        }
+    };
+
+    template <typename ResultType, typename OpType, typename ... ValueType>
+    struct operation
+    {
+        OpType op;
+        std::size_t result;
+        std::array<std::size_t, sizeof ... (ValueType)> args;
+
+        static void run(byte * arena, std::size_t offset)
+        {
+            auto & n = at<operation>(arena, offset);
+            n.call(arena, std::index_sequence_for<ValueType ...> { });
+        }
+
+        template <std::size_t ... I>
+        void call(byte * arena, std::index_sequence<I ...>)
+        {
+            at<ResultType>(arena, result) = op(at<ValueType const>(arena, args[I]) ...);
+        }
+    };
+
+    template <typename T>
+    static void destroy(byte * p) noexcept { reinterpret_cast<T *>(p)->~T(); }
+
+    //! Reserve space for an object of the provided type and return its offset.
+    template <typename T>
+    auto reserve() -> std::size_t
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned types are not supported.");
+
+        auto const offset = (size_ + alignof(T) - 1) / alignof(T) * alignof(T);
+        size_ = offset + sizeof(T);
+        return offset;
+    }
+
+    //! Reserve space for a node result, initialized with the provided arguments.
+    template <typename T, typename ... Args>
+    auto slot(Args && ... args) -> std::size_t
+    {
+        auto const offset = reserve<T>();
+
+        inits_.push_back([this, offset, t = T(std::forward<Args>(args) ...)](auto arena) {
+            ::new (arena + offset) T(t);
+            destructors_.emplace_back(&destroy<T>, offset);
+        });
+
+        return offset;
+    }
+
+    auto base() noexcept -> byte * { return reinterpret_cast<byte *>(arena_.get()); }
+
+private:
+    struct step
+    {
+        void (*run)(byte *, std::size_t);
+        std::size_t node;
+    };
+
+    std::size_t size_ { 0 };
+    std::unique_ptr<std::max_align_t[]> arena_;
+    std::vector<step> steps_;
+    std::vector<std::function<void(byte *)>> inits_;
+    std::vector<std::pair<void (*)(byte *), std::size_t>> destructors_;
+    std::vector<unique_subscription> subs_;
+    subject<void()> changed_;
+};
+
+} } }
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
@@ -13,7 +13,7 @@ namespace filter_detail {
 
 struct abs_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::abs;
@@ -23,7 +23,8 @@ struct abs_
 
 struct div_
 {
-    template <typename X, typename Y>
+    template <typename X, typename Y,
+              typename = expr_detail::enable_if_scalars_t<X, Y>>
     auto operator()(X && x, Y && y) const
     {
         using std::div;
@@ -33,7 +34,7 @@ struct div_
 
 struct exp_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::exp;
@@ -43,7 +44,7 @@ struct exp_
 
 struct exp2_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::exp2;
@@ -53,7 +54,7 @@ struct exp2_
 
 struct log_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::log;
@@ -63,7 +64,7 @@ struct log_
 
 struct log10_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::log10;
@@ -73,7 +74,7 @@ struct log10_
 
 struct log2_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::log2;
@@ -83,7 +84,8 @@ struct log2_
 
 struct pow_
 {
-    template <typename Base, typename Exp>
+    template <typename Base, typename Exp,
+              typename = expr_detail::enable_if_scalars_t<Base, Exp>>
     auto operator()(Base && b, Exp && e) const
     {
         using std::pow;
@@ -93,7 +95,7 @@ struct pow_
 
 struct sqrt_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::sqrt;
@@ -103,7 +105,7 @@ struct sqrt_
 
 struct cbrt_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::cbrt;
@@ -113,7 +115,8 @@ struct cbrt_
 
 struct hypot_
 {
-    template <typename X, typename Y>
+    template <typename X, typename Y,
+              typename = expr_detail::enable_if_scalars_t<X, Y>>
     auto operator()(X && x, Y && y) const
     {
         using std::hypot;
@@ -123,7 +126,7 @@ struct hypot_
 
 struct sin_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::sin;
@@ -133,7 +136,7 @@ struct sin_
 
 struct cos_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::cos;
@@ -143,7 +146,7 @@ struct cos_
 
 struct tan_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::tan;
@@ -153,7 +156,7 @@ struct tan_
 
 struct asin_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::asin;
@@ -163,7 +166,7 @@ struct asin_
 
 struct acos_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::acos;
@@ -173,7 +176,7 @@ struct acos_
 
 struct atan_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::atan;
@@ -183,7 +186,8 @@ struct atan_
 
 struct atan2_
 {
-    template <typename Y, typename X>
+    template <typename Y, typename X,
+              typename = expr_detail::enable_if_scalars_t<Y, X>>
     auto operator()(Y && y, X && x) const
     {
         using std::atan2;
@@ -193,7 +197,7 @@ struct atan2_
 
 struct ceil_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::ceil;
@@ -203,7 +207,7 @@ struct ceil_
 
 struct floor_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::floor;
@@ -213,7 +217,7 @@ struct floor_
 
 struct trunc_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::trunc;
@@ -223,7 +227,7 @@ struct trunc_
 
 struct round_
 {
-    template <typename T>
+    template <typename T, typename = expr_detail::enable_if_scalars_t<T>>
     auto operator()(T && v) const
     {
         using std::round;
@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -8,6 +12,8 @@
 #include <observable/subject.hpp>
 #include <observable/subscription.hpp>
 #include <observable/value.hpp>
+#include <observable/expressions/flat_program.hpp>
+#include <observable/detail/lane_log.hpp>
 
 #include <observable/detail/compiler_config.hpp>
 OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
@@ -19,6 +25,36 @@ template <typename T>
 struct is_expression_node;
 //! \endcond
 
+namespace expr_detail {
+
+//! \cond
+struct compile_tag { };
+
+template <typename Void, typename Op, typename ... ValueType>
+struct lane_state_ : std::false_type { using type = std::tuple<>; };
+
+template <typename Op, typename ... ValueType>
+struct lane_state_<std::void_t<typename Op::template lane_state<ValueType ...>>, Op, ValueType ...> :
+    std::true_type
+{
+    using type = typename Op::template lane_state<ValueType ...>;
+};
+//! \endcond
+
+//! Check if an operation updates the lanes of its previous result in place.
+//!
+//! Such operations have a ``lane_state<ValueType ...>`` member template, for
+//! the state they keep between calls, and an ``update()`` method that is called
+//! with the node's previous result, its lane_log, the state and the child
+//! nodes. The static member ``type`` is the state type, or an empty tuple for
+//! other operations.
+//!
+//! \ingroup observable_detail
+template <typename Op, typename ... ValueType>
+struct lane_state : lane_state_<void, std::decay_t<Op>, ValueType ...> { };
+
+}
+
 //! Expression nodes can form a tree to evaluate arbitrary expressions.
 //!
 //! Expressions are formed from n-ary, user-supplied operators and operands.
@@ -56,6 +92,7 @@ public:
         data_->result = std::forward<ValueType>(constant);
         data_->dirty = false;
         data_->eval = []() { };
+        data_->compile = compile_constant;
     }
 
     //! Create a new node from an observable value.
@@ -82,23 +119,30 @@ public:
                           };
 
         auto update_eval = [d = data_.get()](auto & val) {
-                                d->eval = [=, v = &val]() {
+                                d->eval = [=, v = &val, seen = std::size_t { 0 }]() mutable {
                                     if(!d->dirty)
                                         return;
 
-                                    d->result = v->get();
+                                    detail::assign_lanes(d->result, d->lanes, v->get(), v->lanes_, seen);
                                     d->dirty = false;
                                 };
+
+                                d->compile = [v = &val](auto & program, auto &&) {
+                                    return program.template load<ResultType>(*v);
+                                };
                             };
 
         data_->subs.emplace_back(value.subscribe(mark_dirty));
         update_eval(value);
+        data_->level = value.level_();
 
         data_->subs.emplace_back(value.moved.subscribe(update_eval));
 
         data_->subs.emplace_back(
                 value.destroyed.subscribe([d = data_.get()]() {
+                    d->eval(); // Cache the last value and clear the dirty flag.
                     d->eval = []() { };
+                    d->compile = compile_constant;
                     d->subs.clear();
                 }));
 
@@ -118,44 +162,156 @@ public:
     //!
     //! \param[in] nodes ... Expression nodes who's valuewWW will be the operand to the
     //!                      operation.
-    template <typename OpType, typename ... ValueType>
+    template <typename OpType,
+              typename E = std::enable_if_t<!is_expression_node<OpType>::value>,
+              typename ... ValueType>
     explicit expression_node(OpType && op, expression_node<ValueType> && ... nodes)
     {
         static_assert(std::is_convertible<decltype(op(ValueType { } ...)), ResultType>::value,
                       "Operation must return a type that is convertible to ResultType.");
 
         subscribe_to_nodes(nodes ...);
-
-        data_->eval = [t = std::make_tuple(std::move(nodes) ...),
-                       o = std::forward<OpType>(op),
-                       d = data_.get()]() mutable {
+        data_->level = max_level(nodes ...);
+
+        using lanes = expr_detail::lane_state<OpType, ValueType ...>;
+
+        // The children are stored once, for both eval and compile.
+        struct operation
+        {
+            std::decay_t<OpType> op;
+            std::tuple<expression_node<ValueType> ...> nodes;
+            typename lanes::type lane_state;
+        };
+
+        auto const state = std::make_shared<operation>(
+                                operation { std::forward<OpType>(op),
+                                            std::make_tuple(std::move(nodes) ...),
+                                            { } });
+        data_->operation = state;
+        data_->keep_result = lanes::value;
+
+        data_->compile = [s = state.get()](auto & program, auto &&) {
+                             return compile_tuple<ValueType ...>(program, s->op, s->nodes,
+                                                                 std::index_sequence_for<ValueType ...> { });
+                         };
+
+        data_->eval = [s = state.get(), d = data_.get()]() {
                           if(!d->dirty)
                               return;
 
-                          constexpr auto const size = std::tuple_size<decltype(t)>::value;
-                          constexpr auto const indices = std::make_index_sequence<size> { };
+                          constexpr auto const indices = std::index_sequence_for<ValueType ...> { };
+
+                          if constexpr(lanes::value)
+                          {
+                              update_with_tuple(s->op, *d, s->lane_state, s->nodes, indices);
+                          }
+                          else
+                          {
+                              d->result = call_with_tuple(s->op, s->nodes, indices);
+                              d->lanes.update_all();
+                          }
+
+                          d->dirty = false;
+                      };
+
+        data_->eval();
+    }
+
+    //! Create a new node by compiling a tree of nodes.
+    //!
+    //! Nodes created with this constructor are called compiled nodes. All
+    //! constant, value and n-ary nodes of the tree are flattened into a single
+    //! expr_detail::flat_program, which is evaluated with one loop over its
+    //! nodes, instead of a type-erased eval() call per node. The tree itself is
+    //! released.
+    //!
+    //! Compiled nodes notify their subscribers of changes to any value contained
+    //! in the tree. Once notified, they evaluate the whole program.
+    //!
+    //! \param[in] root Root of the tree to compile.
+    //!
+    //! \see compile()
+    expression_node(expr_detail::compile_tag, expression_node && root)
+    {
+        auto program = std::make_shared<expr_detail::flat_program>();
+        auto const result = root.compile_into(*program);
+        program->link();
+
+        data_->level = root.level();
+        data_->subs.emplace_back(program->subscribe([d = data_.get()]() {
+                                     d->dirty = true;
+                                     d->notify();
+                                 }));
 
-                          d->result = call_with_tuple(o, t, indices);
+        data_->eval = [p = std::move(program), result, d = data_.get()]() {
+                          if(!d->dirty)
+                              return;
+
+                          p->run();
+                          d->result = p->template get<ResultType>(result);
+                          d->lanes.update_all();
                           d->dirty = false;
                       };
 
+        // Compiled nodes are not flattened again, they are evaluated as a unit.
+        data_->compile = [](auto & program, auto && self) {
+                             return program.template load_expression<ResultType>(self);
+                         };
+
+        data_->dirty = true;
         data_->eval();
     }
 
     //! Execute the stored operation and update the node's result value.
     void eval() const { data_->eval(); }
 
+    //! Return true if the node needs to be evaluated.
+    auto dirty() const noexcept { return data_->dirty.load(); }
+
+    //! Return the highest dependency level of the values contained in the tree.
+    //!
+    //! \see value_updater::level()
+    auto level() const noexcept { return data_->level; }
+
     //! Retrieve the expression node's result value.
     //!
     //! This call will not evaluate the node, so this value might be stale. You
     //! can call eval() to make sure that the expression has an updated result
     //! value.
-    auto get() const { return data_->result; }
+    auto get() const noexcept -> ResultType const & { return data_->result; }
+
+    //! Return the record of the lanes changed by the node's last evaluation,
+    //! if the result is an array.
+    auto lanes() const noexcept -> detail::lane_log_t<ResultType> const & { return data_->lanes; }
+
+    //! Retrieve the expression node's result value, moving it out of the node
+    //! if no other node shares it.
+    //!
+    //! Nodes that update the lanes of their previous result in place always
+    //! return a copy.
+    //!
+    //! \warning If the result has been moved, get() returns a moved-from value
+    //!          until the node is evaluated again.
+    auto take() -> ResultType
+    {
+        if(data_.use_count() == 1 && !data_->keep_result)
+            return std::move(data_->result);
+
+        return data_->result;
+    }
 
     //! Subscribe to change notifications from this node.
     template <typename Observer>
     auto subscribe(Observer && callable) { return data_->subscribe(callable); }
 
+    //! Add the nodes of this tree to a flat program.
+    //!
+    //! \return Offset of the node's result inside the program.
+    auto compile_into(expr_detail::flat_program & program) const
+    {
+        return data_->compile(program, *this);
+    }
+
 public:
     //! Expression nodes are not default-constructible.
     expression_node() =default;
@@ -195,6 +351,16 @@ private:
         // Do nothing.
     }
 
+    template <typename ... Nodes>
+    static auto max_level(Nodes & ... nodes) noexcept
+    {
+        auto level = std::size_t { 0 };
+        for(auto l : { std::size_t { 0 }, nodes.level() ... })
+            level = std::max(level, l);
+
+        return level;
+    }
+
     template <typename Tuple, std::size_t I=0>
     static auto eval_tuple(Tuple & nodes) ->
         std::enable_if_t<I < std::tuple_size<Tuple>::value>
@@ -210,6 +376,26 @@ private:
         // Do nothing.
     }
 
+    template <typename ... ValueType, typename Fun, typename Tuple, std::size_t ... I>
+    static auto compile_tuple(expr_detail::flat_program & program,
+                              Fun const & fun,
+                              Tuple const & nodes,
+                              std::index_sequence<I ...>)
+    {
+        // Braced initialization, so children are added in order.
+        auto const operands = std::array<std::size_t, sizeof ... (I)> {
+                                std::get<I>(nodes).compile_into(program) ...
+                              };
+
+        return program.template op<ResultType, ValueType ...>(fun, operands[I] ...);
+    }
+
+    static auto compile_constant(expr_detail::flat_program & program,
+                                 expression_node const & self) -> std::size_t
+    {
+        return program.template constant<ResultType>(self.get());
+    }
+
     template <typename Fun, typename Tuple, std::size_t ... I>
     static auto call_with_tuple(Fun & fun, Tuple & nodes, std::index_sequence<I ...>)
     {
@@ -217,12 +403,25 @@ private:
         return fun(std::get<I>(nodes).get() ...);
     }
 
+    template <typename Fun, typename Data, typename State, typename Tuple, std::size_t ... I>
+    static void update_with_tuple(Fun & fun, Data & d, State & state, Tuple & nodes,
+                                  std::index_sequence<I ...>)
+    {
+        eval_tuple(nodes);
+        fun.update(d.result, d.lanes, state, std::get<I>(nodes) ...);
+    }
+
 private:
     struct data : subject<void()>
     {
         ResultType result;
-        bool dirty = true;
+        detail::lane_log_t<ResultType> lanes;
+        std::atomic<bool> dirty { true };
+        std::size_t level = 0;
         std::function<void()> eval;
+        std::function<std::size_t(expr_detail::flat_program &, expression_node const &)> compile;
+        std::shared_ptr<void> operation;
+        bool keep_result = false;
         std::vector<unique_subscription> subs;
     };
 
@@ -246,6 +445,27 @@ struct is_expression_node_<expression_node<T>> : std::true_type { };
 template <typename T>
 struct is_expression_node : is_expression_node_<std::decay_t<T>> { };
 
+//! Flatten an expression tree into a single, contiguous program.
+//!
+//! The returned node evaluates the same expression as the provided tree, but
+//! stores all of the tree's nodes in one arena and evaluates them with a single,
+//! non-virtual, loop. Use it for large expressions that are evaluated often:
+//!
+//!     auto result = observe(compile(a * x * x + b * x + c));
+//!
+//! Compiled expressions trade incremental evaluation for cheaper evaluation; a
+//! change to any value evaluates the whole tree.
+//!
+//! \param[in] root Root of the tree to compile.
+//! \return A compiled expression node.
+//!
+//! \ingroup observable_expressions
+template <typename ResultType>
+inline auto compile(expression_node<ResultType> && root)
+{
+    return expression_node<ResultType> { expr_detail::compile_tag { }, std::move(root) };
+}
+
 } }
 
 OBSERVABLE_END_CONFIGURE_WARNINGS
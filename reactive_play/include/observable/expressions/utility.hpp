@@ -1,6 +1,7 @@
 #pragma once
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <observable/value.hpp>
 #include <observable/expressions/tree.hpp>
 
@@ -70,25 +71,81 @@ struct val_type : val_type_<std::decay_t<T>> { };
 template <typename T>
 using val_type_t = typename val_type<T>::type;
 
+//! \cond
+template <typename T>
+struct is_array_ : std::false_type { };
+
+template <typename T, typename A>
+struct is_array_<std::vector<T, A>> : std::true_type { };
+//! \endcond
+
+//! Check if a type is an array, a ``std::vector``.
+//!
+//! The static member ``value`` will be true if the provided type is an array or
+//! an expression_node or observable value<ValueType, EqualityComparator> that
+//! holds an array.
+//!
+//! \ingroup observable_detail
+template <typename T>
+struct is_array : is_array_<std::decay_t<val_type_t<T>>> { };
+
+//! Check if any of the provided types are arrays.
+//!
+//! \see is_array
+//! \ingroup observable_detail
+template <typename ... T>
+struct are_any_arrays;
+
+//! \cond
+template <typename H, typename ... T>
+struct are_any_arrays<H, T ...> :
+    std::integral_constant<bool, is_array<H>::value ||
+                                 are_any_arrays<T ...>::value>
+{ };
+
+template <>
+struct are_any_arrays<> : std::false_type
+{ };
+//! \endcond
+
+//! Disable scalar expression filters for array arguments, so the elementwise
+//! filters can be used instead.
+//!
+//! \ingroup observable_detail
+template <typename ... T>
+using enable_if_scalars_t = std::enable_if_t<!are_any_arrays<T ...>::value>;
+
 //! Computes the type of the expression_node created for an expression with
 //! callable ``Op`` and corresponding arguments.
 //!
 //! \ingroup observable_detail
 template <typename Op, typename ... Args>
-struct result_node
-{
+struct result_node;
+
+//! \cond
 #if defined(__cpp_lib_invoke) && __cpp_lib_invoke && defined(_HAS_CXX17) && _HAS_CXX17
-    using type = expression_node<
-                    std::decay_t<
-                        std::invoke_result_t<
-                            std::decay_t<Op>, val_type_t<Args> ...>>>;
+template <typename Op, typename ... Args>
+using invoke_result_t = std::invoke_result_t<std::decay_t<Op>, val_type_t<Args> ...>;
 #else
-    using type = expression_node<
-                    std::decay_t<
-                        std::result_of_t<
-                            std::decay_t<Op>(val_type_t<Args> ...)>>>;
+template <typename Op, typename ... Args>
+using invoke_result_t = std::result_of_t<std::decay_t<Op>(val_type_t<Args> ...)>;
 #endif
+
+template <typename Void, typename Op, typename ... Args>
+struct result_node_ { };
+
+// No type if Op cannot be called with Args, so filters that do not accept the
+// arguments are not considered by overload resolution.
+template <typename Op, typename ... Args>
+struct result_node_<std::void_t<invoke_result_t<Op, Args ...>>, Op, Args ...>
+{
+    using type = expression_node<std::decay_t<invoke_result_t<Op, Args ...>>>;
 };
+//! \endcond
+
+template <typename Op, typename ... Args>
+struct result_node : result_node_<void, Op, Args ...>
+{ };
 
 //! Type of the expression_node created for an expression with callable ``Op`` and
 //! corresponding arguments.
@@ -1,9 +1,13 @@
 #pragma once
 
 // All the useful headers.
+#include <observable/batch.hpp>
+#include <observable/concurrent_value.hpp>
 #include <observable/subject.hpp>
+#include <observable/thread_pool.hpp>
 #include <observable/value.hpp>
 #include <observable/observe.hpp>
+#include <observable/expressions/array.hpp>
 #include <observable/expressions/filters.hpp>
 #include <observable/expressions/math.hpp>
 
@@ -1,6 +1,16 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
+#include <vector>
+#include <observable/thread_pool.hpp>
 #include <observable/value.hpp>
 #include <observable/expressions/expression.hpp>
 #include <observable/expressions/operators.hpp>
@@ -29,6 +39,196 @@ private:
     using expr::expression_evaluator::eval_all;
 };
 
+//! Update all observable values that were associated with an updater instance,
+//! evaluating independent expressions in parallel.
+//!
+//! Expressions are grouped by their level: expressions that only read values
+//! which are set directly are on level 1, expressions that read the results of
+//! level 1 expressions are on level 2, and so on. Levels are evaluated one
+//! after the other; the expressions inside a level do not depend on each other
+//! and are evaluated in parallel, on a thread_pool owned by the updater.
+//!
+//! Expressions whose inputs have not changed since their last evaluation are
+//! skipped and do not update their values.
+//!
+//! \note Copies of a parallel_updater share the same expressions and threads.
+//!
+//! \warning Observers of the updated values are called from the pool's threads
+//!          and must be safe to call in parallel. Expression trees must not
+//!          share nodes.
+//!
+//! \ingroup observable
+class parallel_updater : public updater
+{
+public:
+    //! Number of expressions handled by an update_all() call.
+    struct stats
+    {
+        //! Expressions that have been evaluated.
+        std::size_t evaluated = 0;
+
+        //! Expressions that have been skipped, because their inputs have not
+        //! changed.
+        std::size_t skipped = 0;
+    };
+
+    //! Create an updater.
+    //!
+    //! \param[in] thread_count Number of threads used to evaluate expressions.
+    explicit parallel_updater(std::size_t thread_count = std::thread::hardware_concurrency()) :
+        data_ { std::make_shared<data>(thread_count) }
+    { }
+
+    //! Update all observable values that have been associated with this
+    //! instance.
+    //!
+    //! If an expression throws, the remaining expressions of its level are still
+    //! evaluated and the first exception is rethrown before the next level.
+    //!
+    //! \note This method can be safely called in parallel, from multiple
+    //!       threads; the calls are serialized.
+    auto update_all() -> stats
+    {
+        std::lock_guard<std::mutex> const lock { data_->mutex };
+
+        auto & entries = data_->entries;
+        if(!data_->sorted)
+        {
+            // Stable, so expressions keep their creation order inside a level.
+            std::stable_sort(begin(entries), end(entries),
+                             [](auto && a, auto && b) { return a.level < b.level; });
+            data_->sorted = true;
+        }
+
+        auto result = stats { };
+
+        for(auto first = begin(entries); first != end(entries);)
+        {
+            auto const last = std::find_if(first, end(entries),
+                                           [&](auto && e) { return e.level != first->level; });
+
+            eval_level(&*first, static_cast<std::size_t>(last - first), result);
+            first = last;
+        }
+
+        return result;
+    }
+
+private:
+    using id = void const *;
+
+    struct entry
+    {
+        id key;
+        std::size_t level;
+        std::function<bool()> eval;
+    };
+
+    struct data
+    {
+        explicit data(std::size_t thread_count) : pool { thread_count } { }
+
+        std::vector<entry> entries;
+        bool sorted = true;
+        std::mutex mutex;
+        thread_pool pool;
+    };
+
+    //! Evaluate a range of expressions that do not depend on each other.
+    void eval_level(entry * entries, std::size_t count, stats & result)
+    {
+        auto const run = [entries](std::size_t begin, std::size_t end) {
+            auto evaluated = std::size_t { 0 };
+            for(auto i = begin; i < end; ++i)
+                evaluated += entries[i].eval() ? 1 : 0;
+
+            return evaluated;
+        };
+
+        auto const chunk_count = std::min(count, data_->pool.concurrency() * 4);
+        if(chunk_count < 2)
+        {
+            auto const evaluated = run(0, count);
+            result.evaluated += evaluated;
+            result.skipped += count - evaluated;
+            return;
+        }
+
+        auto const chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        std::atomic<std::size_t> evaluated { 0 };
+        std::atomic<std::size_t> pending { (count + chunk_size - 1) / chunk_size };
+        std::atomic<bool> failed { false };
+        std::exception_ptr error;
+        std::promise<void> done;
+
+        for(std::size_t begin = 0; begin < count; begin += chunk_size)
+        {
+            auto const end = std::min(begin + chunk_size, count);
+
+            data_->pool.post([&, begin, end]() {
+                try {
+                    evaluated += run(begin, end);
+                } catch(...) {
+                    if(!failed.exchange(true))
+                        error = std::current_exception();
+                }
+
+                if(--pending == 0)
+                    done.set_value();
+            });
+        }
+
+        done.get_future().wait();
+
+        result.evaluated += evaluated;
+        result.skipped += count - evaluated;
+
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    //! Register a new expression to be evaluated by this updater.
+    template <typename ExpressionType>
+    auto insert(ExpressionType * expr)
+    {
+        assert(expr);
+        std::lock_guard<std::mutex> const lock { data_->mutex };
+
+        auto const eval = [=]() {
+            if(!expr->dirty())
+                return false;
+
+            expr->eval();
+            return true;
+        };
+
+        data_->entries.push_back(entry { expr, expr->level(), eval });
+        data_->sorted = false;
+        return id { expr };
+    }
+
+    //! Unregister a previously registered expression.
+    void remove(id instance_id)
+    {
+        std::lock_guard<std::mutex> const lock { data_->mutex };
+
+        auto & entries = data_->entries;
+        auto const it = std::find_if(begin(entries),
+                                     end(entries),
+                                     [&](auto && e) { return e.key == instance_id; });
+        assert(it != end(entries));
+        if(it != end(entries))
+            entries.erase(it);
+    }
+
+private:
+    std::shared_ptr<data> data_;
+
+    template <typename ValueType, typename UpdaterType>
+    friend class expr::expression;
+};
+
 //! Observe changes to a single value with automatic synchronization.
 //!
 //! Returns an observable value that is kept in-sync with the provided value.
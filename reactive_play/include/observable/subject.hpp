@@ -1,9 +1,17 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <functional>
+#include <future>
 #include <memory>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <observable/detail/collection.hpp>
+#include <observable/detail/inline_function.hpp>
+#include <observable/detail/snapshot_collection.hpp>
 #include <observable/detail/type_traits.hpp>
 #include <observable/subscription.hpp>
 
@@ -15,6 +23,11 @@ namespace observable {
 //! \cond
 template <typename ...>
 class subject;
+
+template <typename ObserverType,
+          template <typename> class Collection,
+          typename Function = std::function<ObserverType>>
+class basic_subject;
 //! \endcond
 
 //! Store observers and provide a way to notify them when events occur.
@@ -33,12 +46,21 @@ class subject;
 //! \tparam Args Observer arguments. All observer types must be storable
 //!              inside a ``std::function<void(Args ...)>``.
 //!
+//! \tparam Collection Container that stores the observers. Use
+//!                    detail::collection for cheap subscribe() calls or
+//!                    detail::snapshot_collection for cheap notify() calls.
+//! \tparam Function Type that each observer is stored as. Must be callable
+//!                  with ``Args ...`` and copy constructible from the
+//!                  subscribed observers.
+//!
 //! \warning Even though subjects themselves are safe to use in parallel,
 //!          observers need to handle being called from multiple threads too.
 //!
+//! \see subject<void(Args ...)>
+//! \see snapshot_subject
 //! \ingroup observable
-template <typename ... Args>
-class subject<void(Args ...)>
+template <typename ... Args, template <typename> class Collection, typename Function>
+class basic_subject<void(Args ...), Collection, Function>
 {
 public:
     using observer_type = void(Args ...);
@@ -155,6 +177,98 @@ public:
         observers_->apply([&](auto && observer) { observer(arguments ...); });
     }
 
+    //! Notify all currently subscribed observers in parallel, on an executor.
+    //!
+    //! The observers are split into chunks and every chunk is posted to the
+    //! executor as one task. The method returns immediately.
+    //!
+    //! \note The observers that will be called are the ones subscribed when
+    //!       the method is called. Observers removed afterwards may still be
+    //!       called.
+    //!
+    //! \note With a subject that uses detail::collection, the observers are
+    //!       copied on every call. A snapshot_subject shares its observers with
+    //!       the tasks instead.
+    //!
+    //! \param[in] executor Executor that will run the observers. Must provide
+    //!                     ``post(std::function<void()>)`` and
+    //!                     ``concurrency()``, like thread_pool. It must remain
+    //!                     valid until the returned future is ready.
+    //! \param[in] arguments Arguments that will be copied and passed to the
+    //!                      subscribed observers.
+    //!
+    //! \return A future that becomes ready once all observers have been
+    //!         called. If an observer throws, the future holds the first
+    //!         exception; the other observers are still called.
+    //!
+    //! \warning All observers must be safe to call in parallel and must remain
+    //!          valid until the returned future is ready.
+    template <typename Executor>
+    auto notify_parallel(Executor & executor, Args ... arguments) const -> std::future<void>
+    {
+        assert(observers_);
+
+        struct shared_state
+        {
+            decltype(observers_->view()) observers;
+            std::tuple<std::decay_t<Args> ...> arguments;
+            std::atomic<std::size_t> pending;
+            std::atomic<bool> failed { false };
+            std::exception_ptr error;
+            std::promise<void> done;
+        };
+
+        auto state = std::make_shared<shared_state>();
+        state->observers = observers_->view();
+        state->arguments = std::make_tuple(arguments ...);
+
+        auto const count = state->observers->size();
+        auto future = state->done.get_future();
+
+        if(count == 0)
+        {
+            state->done.set_value();
+            return future;
+        }
+
+        auto const chunk_count = std::min<std::size_t>(
+                                    count,
+                                    std::max<std::size_t>(executor.concurrency(), 1) * 4);
+        auto const chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        state->pending = (count + chunk_size - 1) / chunk_size;
+
+        for(std::size_t begin = 0; begin < count; begin += chunk_size)
+        {
+            auto const end = std::min(begin + chunk_size, count);
+
+            executor.post([state, begin, end]() {
+                for(auto i = begin; i < end; ++i)
+                {
+                    try {
+                        call_with_tuple((*state->observers)[i],
+                                        state->arguments,
+                                        std::index_sequence_for<Args ...> { });
+                    } catch(...) {
+                        if(!state->failed.exchange(true))
+                            state->error = std::current_exception();
+                    }
+                }
+
+                // The last chunk publishes the result.
+                if(--state->pending > 0)
+                    return;
+
+                if(state->error)
+                    state->done.set_exception(state->error);
+                else
+                    state->done.set_value();
+            });
+        }
+
+        return future;
+    }
+
     //! Return true if there are no subscribers.
     auto empty() const noexcept
     {
@@ -164,26 +278,83 @@ public:
 
 public:
     //! Constructor. Will create an empty subject.
-    subject() =default;
+    basic_subject() =default;
 
     //! Subjects are **not** copy-constructible.
-    subject(subject const &) =delete;
+    basic_subject(basic_subject const &) =delete;
 
     //! Subjects are **not** copy-assignable.
-    auto operator=(subject const &) -> subject & =delete;
+    auto operator=(basic_subject const &) -> basic_subject & =delete;
 
     //! Subjects are move-constructible.
-    subject(subject &&) noexcept =default;
+    basic_subject(basic_subject &&) noexcept =default;
 
     //! Subjects are move-assignable.
-    auto operator=(subject &&) noexcept -> subject & =default;
+    auto operator=(basic_subject &&) noexcept -> basic_subject & =default;
 
 private:
-    using collection = detail::collection<std::function<observer_type>>;
+    template <typename Observer, typename Tuple, std::size_t ... I>
+    static void call_with_tuple(Observer const & observer, Tuple & arguments, std::index_sequence<I ...>)
+    {
+        observer(std::get<I>(arguments) ...);
+    }
+
+    using collection = Collection<Function>;
 
     std::shared_ptr<collection> observers_ { std::make_shared<collection>() };
 };
 
+//! Subject that stores its observers in a detail::collection.
+//!
+//! Subscribing and unsubscribing are cheap and notify() walks a list of
+//! observers.
+//!
+//! \see basic_subject<void(Args ...), Collection, Function>
+//! \ingroup observable
+template <typename ... Args>
+class subject<void(Args ...)> : public basic_subject<void(Args ...), detail::collection>
+{
+public:
+    using basic_subject<void(Args ...), detail::collection>::basic_subject;
+};
+
+//! Subject that stores its observers in a detail::snapshot_collection.
+//!
+//! notify() scans a contiguous array of observers, while subscribing and
+//! unsubscribing copy that array. Use it for subjects that are notified much
+//! more often than their observers change.
+//!
+//! \see basic_subject<void(Args ...), Collection, Function>
+//! \ingroup observable
+template <typename ObserverType>
+using snapshot_subject = basic_subject<ObserverType, detail::snapshot_collection>;
+
+//! Subject that stores its observers in a detail::inline_function.
+//!
+//! Observers are stored without any allocation besides the collection node,
+//! as long as they are at most ``Capacity`` bytes large; larger observers do
+//! not compile.
+//!
+//! \see basic_subject<void(Args ...), Collection, Function>
+//! \ingroup observable
+template <typename ObserverType, std::size_t Capacity = 4 * sizeof(void *)>
+using inline_subject = basic_subject<ObserverType,
+                                     detail::collection,
+                                     detail::inline_function<ObserverType, Capacity>>;
+
+//! Subject whose observers are all of the same, known, type.
+//!
+//! There is no type erasure, so notify() can inline the observer calls. This is
+//! mostly useful with lambdas or function objects.
+//!
+//! \tparam ObserverType The function type of the observers.
+//! \tparam Observer Type of every subscribed observer.
+//!
+//! \see basic_subject<void(Args ...), Collection, Function>
+//! \ingroup observable
+template <typename ObserverType, typename Observer>
+using typed_subject = basic_subject<ObserverType, detail::collection, Observer>;
+
 //! Subject specialization that can be used inside a class, as a member, to
 //! prevent external code from calling notify(), but still allow anyone to
 //! subscribe.
@@ -209,6 +380,9 @@ private:
     //! \see subject<void(Args...)>::notify
     using subject<ObserverType>::notify;
 
+    //! \see basic_subject<void(Args ...), Collection, Function>::notify_parallel
+    using subject<ObserverType>::notify_parallel;
+
     friend EnclosingType;
 };
 
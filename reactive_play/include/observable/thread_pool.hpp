@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <observable/detail/compiler_config.hpp>
+OBSERVABLE_BEGIN_CONFIGURE_WARNINGS
+
+namespace observable {
+
+//! Fixed set of threads that run posted tasks in FIFO order.
+//!
+//! This is the default executor for subject::notify_parallel(). Any type that
+//! provides the same post() and concurrency() methods can be used instead.
+//!
+//! All methods can be safely called in parallel, from multiple threads.
+//!
+//! \ingroup observable
+class thread_pool final
+{
+public:
+    //! Create a pool and start its threads.
+    //!
+    //! \param[in] thread_count Number of threads. At least one thread is always
+    //!                         started.
+    explicit thread_pool(std::size_t thread_count = std::thread::hardware_concurrency())
+    {
+        thread_count = std::max<std::size_t>(thread_count, 1);
+        threads_.reserve(thread_count);
+
+        for(std::size_t i = 0; i < thread_count; ++i)
+            threads_.emplace_back([this]() { run(); });
+    }
+
+    //! Queue a task to be run by one of the pool's threads.
+    //!
+    //! \param[in] task Callable that takes no arguments. Exceptions thrown by
+    //!                 the task are ignored.
+    void post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> const lock { mutex_ };
+            tasks_.push_back(std::move(task));
+        }
+
+        ready_.notify_one();
+    }
+
+    //! Return the number of threads in the pool.
+    auto concurrency() const noexcept { return threads_.size(); }
+
+    //! Destructor. Runs all queued tasks, then stops the threads.
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> const lock { mutex_ };
+            stopped_ = true;
+        }
+
+        ready_.notify_all();
+
+        for(auto & t : threads_)
+            t.join();
+    }
+
+public:
+    //! Thread pools are not copy-constructible.
+    thread_pool(thread_pool const &) =delete;
+
+    //! Thread pools are not copy-assignable.
+    auto operator=(thread_pool const &) -> thread_pool & =delete;
+
+    //! Thread pools are not move-constructible.
+    thread_pool(thread_pool &&) =delete;
+
+    //! Thread pools are not move-assignable.
+    auto operator=(thread_pool &&) -> thread_pool & =delete;
+
+private:
+    void run()
+    {
+        for(;;)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock { mutex_ };
+                ready_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+
+                if(tasks_.empty())
+                    return;
+
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            try {
+                task();
+            } catch(...) {
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopped_ { false };
+};
+
+}
+
+OBSERVABLE_END_CONFIGURE_WARNINGS
@@ -1,12 +1,15 @@
 #pragma once
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <observable/subject.hpp>
 #include <observable/subscription.hpp>
+#include <observable/detail/lane_log.hpp>
 #include <observable/detail/type_traits.hpp>
 
 #include <observable/detail/compiler_config.hpp>
@@ -21,6 +24,11 @@ class value;
 template <typename ValueType>
 class value_updater;
 
+inline namespace expr {
+template <typename ResultType>
+class expression_node;
+}
+
 namespace detail {
 
 struct equal_to
@@ -114,11 +122,8 @@ public:
     explicit value(std::unique_ptr<UpdaterType> && ud) :
         updater_ { std::move(ud) }
     {
-        using namespace std::placeholders;
-
-        updater_->set_value_notifier(std::bind(&value<ValueType>::set_impl,
-                                               this,
-                                                std::placeholders::_1));
+        updater_->set_value_notifier(updater_notifier());
+        updater_->set_lanes_notifier(lanes_notifier());
         set_impl(updater_->get());
     }
 
@@ -193,24 +198,63 @@ public:
     //! If the new value compares equal to the existing value, this method has no
     //! effect. The comparison is performed using the EqualityComparator.
     //!
+    //! The new value is only copied if it is different from the existing one.
+    //!
     //! \param new_value The new value to set.
     //! \throw readonly_value if the value has an associated updater.
     //! \see subject<void(Args ...)>::notify()
-    void set(ValueType new_value)
+    void set(ValueType const & new_value)
     {
-        if(updater_)
-            throw readonly_value {
-                "Can't set a value that has an associated updater. These values "
-                "are readonly."
-            };
+        check_writable();
+        set_impl(new_value);
+    }
 
+    //! Set a new value, possibly notifying any subscribed observers.
+    //!
+    //! The new value is moved into the observable value, if it is different from
+    //! the existing one.
+    //!
+    //! \see set(ValueType const &)
+    void set(ValueType && new_value)
+    {
+        check_writable();
         set_impl(std::move(new_value));
     }
 
+    //! Set some of the lanes of an array value, possibly notifying any
+    //! subscribed observers.
+    //!
+    //! Only the provided lanes are compared and assigned, and expressions that
+    //! depend on the value only recompute the lanes that changed, instead of
+    //! comparing the whole array.
+    //!
+    //! \param indices Indices of the lanes to set.
+    //! \param values New lane values, in the same order as ``indices``.
+    //! \throw readonly_value if the value has an associated updater.
+    //! \note Only available for values that hold a ``std::vector``.
+    template <typename Indices, typename Values, typename V = ValueType>
+    auto set_lanes(Indices const & indices, Values const & values)
+        -> std::enable_if_t<detail::has_lanes<V>::value>
+    {
+        check_writable();
+        set_lanes_impl(indices, [v = std::begin(values)](std::size_t) mutable -> decltype(auto) {
+                                    return *v++;
+                                });
+    }
+
+    //! Set a new value. Will just call set(ValueType const &).
+    //!
+    //! \see set(ValueType const &)
+    auto operator=(ValueType const & new_value) -> value &
+    {
+        set(new_value);
+        return *this;
+    }
+
     //! Set a new value. Will just call set(ValueType &&).
     //!
     //! \see set(ValueType &&)
-    auto operator=(ValueType new_value) -> value &
+    auto operator=(ValueType && new_value) -> value &
     {
         set(std::move(new_value));
         return *this;
@@ -245,16 +289,17 @@ public:
         moved { std::move(other.moved) },
         destroyed { std::move(other.destroyed) },
         value_(std::move(other.value_)),
+        lanes_ { std::move(other.lanes_) },
         eq_ { std::move(other.eq_) },
         void_observers_ { std::move(other.void_observers_) },
         value_observers_ { std::move(other.value_observers_) },
         updater_ { std::move(other.updater_) }
     {
-        using namespace std::placeholders;
         if(updater_)
-            updater_->set_value_notifier(std::bind(&value<ValueType>::set_impl,
-                                                   this,
-                                                   std::placeholders::_1));
+        {
+            updater_->set_value_notifier(updater_notifier());
+            updater_->set_lanes_notifier(lanes_notifier());
+        }
 
         moved.notify(*this);
         other.destroyed = decltype(destroyed) { };
@@ -266,21 +311,22 @@ public:
         noexcept(std::is_nothrow_move_assignable<ValueType>::value)
         -> value<ValueType> &
     {
-        using namespace std::placeholders;
-
         moved = std::move(other.moved);
         destroyed = std::move(other.destroyed);
 
         value_ = std::move(other.value_);
+        lanes_ = std::move(other.lanes_);
+        lanes_.update_all();
         void_observers_ = std::move(other.void_observers_);
         value_observers_ = std::move(other.value_observers_);
         updater_ = std::move(other.updater_);
         eq_ = std::move(other.eq_);
 
         if(updater_)
-            updater_->set_value_notifier(std::bind(&value<ValueType>::set_impl,
-                                                   this,
-                                                   std::placeholders::_1));
+        {
+            updater_->set_value_notifier(updater_notifier());
+            updater_->set_lanes_notifier(lanes_notifier());
+        }
 
         moved.notify(*this);
         other.destroyed = decltype(destroyed) { };
@@ -322,18 +368,76 @@ private:
         observer(value_);
     }
 
-    void set_impl(ValueType new_value)
+    void check_writable() const
+    {
+        if(updater_)
+            throw readonly_value {
+                "Can't set a value that has an associated updater. These values "
+                "are readonly."
+            };
+    }
+
+    template <typename ValueType_>
+    void set_impl(ValueType_ && new_value)
     {
         if(eq_(value_, new_value))
             return;
 
-        value_ = std::move(new_value);
+        value_ = std::forward<ValueType_>(new_value);
+        lanes_.update_all();
+        void_observers_.notify();
+        value_observers_.notify(value_);
+    }
+
+    //! Return a notifier that moves new values from the updater into this value.
+    auto updater_notifier() noexcept
+    {
+        return [this](ValueType && new_value) { set_impl(std::move(new_value)); };
+    }
+
+    //! Assign the lanes of an array value that differ from the new ones, and
+    //! notify the observers if any did.
+    //!
+    //! \param lane Called once for each index, in order, with the index. Returns
+    //!             the new value of the lane.
+    template <typename Indices, typename Lane>
+    void set_lanes_impl(Indices const & indices, Lane lane)
+    {
+        auto changed = std::vector<std::size_t> { };
+
+        for(auto i : indices)
+        {
+            auto && new_lane = lane(i);
+            if(detail::equal_to { }(value_[i], new_lane))
+                continue;
+
+            value_[i] = std::forward<decltype(new_lane)>(new_lane);
+            changed.push_back(i);
+        }
+
+        if(changed.empty())
+            return;
+
+        lanes_.update(std::move(changed));
         void_observers_.notify();
         value_observers_.notify(value_);
     }
 
+    //! Return a notifier that copies the changed lanes of an array from the
+    //! updater into this value.
+    auto lanes_notifier() noexcept
+    {
+        return [this](ValueType const & new_value, std::vector<std::size_t> const & lanes) {
+            if constexpr(detail::has_lanes<ValueType>::value)
+                set_lanes_impl(lanes, [&new_value](std::size_t i) -> auto const & { return new_value[i]; });
+            else
+                set_impl(new_value);
+        };
+    }
+
 private:
     ValueType value_;
+    detail::lane_log_t<ValueType> lanes_;
 
     std::function<bool(ValueType const &, ValueType const &)> eq_ {
         [](auto && a, auto && b) { return detail::equal_to { }(a, b); }
@@ -343,8 +447,18 @@ private:
     mutable value_subject value_observers_;
     std::unique_ptr<value_updater<ValueType>> updater_;
 
+    //! Return the dependency level of the value: 0 for values that are set
+    //! directly, else the level of the updater.
+    auto level_() const noexcept -> std::size_t
+    {
+        return updater_ ? updater_->level() : 0;
+    }
+
     template <typename, typename ...>
     friend class value;
+
+    template <typename>
+    friend class expr::expression_node;
 };
 
 //! Value specialization that can be used inside a class, as a member, to
@@ -371,6 +485,7 @@ public:
 
 private:
     using value<ValueType>::set;
+    using value<ValueType>::set_lanes;
     using value<ValueType>::operator=;
 
     value(value<ValueType, EnclosingType> &&) =default;
@@ -391,6 +506,32 @@ private:
     friend EnclosingType;
 };
 
+//! Immutable payload that can be shared by values, expressions and observers.
+//!
+//! Store a snapshot in an observable value, instead of the payload itself, to
+//! pass large payloads, like images or meshes, through values and expressions
+//! without copying them; every copy only updates a reference count. Snapshots
+//! compare by identity, so setting a new snapshot does not compare payloads.
+//!
+//! Example:
+//!
+//!     observable::value<observable::snapshot<image>> frame;
+//!     frame = observable::make_snapshot<image>(width, height);
+//!
+//! \ingroup observable
+template <typename ValueType>
+using snapshot = std::shared_ptr<ValueType const>;
+
+//! Create a new snapshot, constructing its payload from the provided
+//! arguments.
+//!
+//! \ingroup observable
+template <typename ValueType, typename ... Args>
+inline auto make_snapshot(Args && ... args) -> snapshot<ValueType>
+{
+    return std::make_shared<ValueType const>(std::forward<Args>(args) ...);
+}
+
 // Properties
 
 //! Macro that enables observable properties for a class.
@@ -456,9 +597,27 @@ public:
     //! \param[in] notifier Functor that will notify the value of a change.
     virtual void set_value_notifier(std::function<void(ValueType &&)> const & notifier) =0;
 
+    //! Set a functor that can be used to notify the value to be updated that
+    //! only some lanes of an array changed.
+    //!
+    //! Updaters that do not know which lanes changed can ignore it and always
+    //! use the value notifier.
+    //!
+    //! \param[in] notifier Functor that will copy the listed lanes of the new
+    //!                     value into the value.
+    virtual void set_lanes_notifier(
+        std::function<void(ValueType const &, std::vector<std::size_t> const &)> const &)
+    { }
+
     //! Retrieve the current value.
     virtual auto get() const -> ValueType =0;
 
+    //! Return the dependency level of the updated value.
+    //!
+    //! An updater that reads other values must return a level greater than the
+    //! level of all of them.
+    virtual auto level() const noexcept -> std::size_t { return 0; }
+
     //! Destructor.
     virtual ~value_updater() { }
 
@@ -11,8 +11,14 @@
 
 #include "react/detail/Defs.h"
 
+#include <cstdint>
+#include <istream>
 #include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "react/detail/DomainBase.h"
 #include "react/detail/ReactiveInput.h"
@@ -420,6 +426,155 @@ void AsyncTransaction(TransactionFlagsT flags, TransactionStatus& status, F&& fu
         .AsyncTransaction(flags, status.statePtr_, std::forward<F>(func));
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// DoBulkConstruction
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Nodes created by func are attached in bulk when it returns, if the engine supports it:
+// the toposort engines compute the levels in one pass and store the successors in one block.
+// func must not change any input, and no other thread may create nodes of D meanwhile.
+template <typename D, typename F>
+void DoBulkConstruction(F&& func)
+{
+    struct BulkScope_
+    {
+        BulkScope_()    { D::Engine::OnBulkAttachBegin(); }
+        ~BulkScope_()   { D::Engine::OnBulkAttachEnd(); }
+    };
+
+    BulkScope_ scope;
+    func();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// SaveValue, LoadValue
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Used by SignalCheckpoint to write values to a stream and read them back. Trivially copyable
+// types are written as they are in memory, so only for the same build and platform. Overload
+// both, in the namespace of the type, to checkpoint other types.
+template <typename S>
+auto SaveValue(std::ostream& os, const S& value)
+    -> typename std::enable_if<std::is_trivially_copyable<S>::value>::type
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(S));
+}
+
+template <typename S>
+auto LoadValue(std::istream& is, S& value)
+    -> typename std::enable_if<std::is_trivially_copyable<S>::value>::type
+{
+    is.read(reinterpret_cast<char*>(&value), sizeof(S));
+}
+
+inline void SaveValue(std::ostream& os, const std::string& value)
+{
+    SaveValue(os, static_cast<uint64_t>(value.size()));
+    os.write(value.data(), value.size());
+}
+
+inline void LoadValue(std::istream& is, std::string& value)
+{
+    uint64_t size = 0;
+    LoadValue(is, size);
+
+    if (!is)
+        return;
+
+    value.resize(size);
+    is.read(&value[0], size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// SignalCheckpoint
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Saves the values of a set of VarSignals and restores them later in a single transaction,
+// so every dependent node is updated at most once.
+// The saved values can be written to a stream and loaded into a checkpoint of another
+// process that tracks the same signals in the same order, e.g. to restart in the last state.
+template <typename D>
+class SignalCheckpoint
+{
+    struct IEntry_
+    {
+        virtual ~IEntry_() {}
+
+        virtual void Save() = 0;
+        virtual void Restore() = 0;
+
+        virtual void Write(std::ostream& os) const = 0;
+        virtual void Read(std::istream& is) = 0;
+    };
+
+    template <typename S>
+    struct Entry_ : public IEntry_
+    {
+        explicit Entry_(const VarSignal<D,S>& signal) :
+            MySignal( signal ),
+            MyValue( signal.Value() )
+        {}
+
+        virtual void Save() override      { MyValue = MySignal.Value(); }
+        virtual void Restore() override   { MySignal.Set(MyValue); }
+
+        virtual void Write(std::ostream& os) const override   { SaveValue(os, MyValue); }
+        virtual void Read(std::istream& is) override          { LoadValue(is, MyValue); }
+
+        VarSignal<D,S>  MySignal;
+        S               MyValue;
+    };
+
+public:
+    // Also saves the current value
+    template <typename S>
+    void Track(const VarSignal<D,S>& signal)
+    {
+        entries_.emplace_back(new Entry_<S>(signal));
+    }
+
+    void Save()
+    {
+        for (auto& e : entries_)
+            e->Save();
+    }
+
+    // Writes the saved values
+    void Save(std::ostream& os) const
+    {
+        SaveValue(os, static_cast<uint64_t>(entries_.size()));
+
+        for (const auto& e : entries_)
+            e->Write(os);
+    }
+
+    // Replaces the saved values with those written by Save(std::ostream&); Restore() sets them.
+    // Returns false if the stream does not hold as many values as there are tracked signals,
+    // or could not be read. The saved values are unspecified in that case.
+    bool Load(std::istream& is)
+    {
+        uint64_t count = 0;
+        LoadValue(is, count);
+
+        if (!is || count != entries_.size())
+            return false;
+
+        for (auto& e : entries_)
+            e->Read(is);
+
+        return !is.fail();
+    }
+
+    void Restore()
+    {
+        DoTransaction<D>([this]
+            {
+                for (auto& e : entries_)
+                    e->Restore();
+            });
+    }
+
+private:
+    std::vector<std::unique_ptr<IEntry_>>   entries_;
+};
+
 /******************************************/ REACT_END /******************************************/
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
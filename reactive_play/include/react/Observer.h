@@ -36,6 +36,9 @@ class Events;
 using REACT_IMPL::ObserverAction;
 using REACT_IMPL::WeightHint;
 
+using REACT_IMPL::IExecutor;
+using REACT_IMPL::ThreadPoolExecutor;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Observer
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +198,51 @@ auto Observe(const Signal<D,S>& subject, FIn&& func)
     return Observer<D>( rawNodePtr, subjectPtr );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Observe - Signals (asynchronous)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// The observer is called on the given executor rather than during propagation.
+// Intermediate values are dropped if the observer falls behind; only the latest is delivered.
+// The executor is held by reference and must outlive the observer. After Detach() or the
+// destruction of the observer, pending values are no longer delivered, but a call already
+// in progress on the executor may still finish.
+template
+<
+    typename D,
+    typename FIn,
+    typename S
+>
+auto Observe(const Signal<D,S>& subject, IExecutor& executor, FIn&& func)
+    -> Observer<D>
+{
+    using REACT_IMPL::IObserver;
+    using REACT_IMPL::ObserverNode;
+    using REACT_IMPL::AsyncSignalObserverNode;
+    using REACT_IMPL::AddDefaultReturnValueWrapper;
+
+    using F = typename std::decay<FIn>::type;
+    using R = typename std::result_of<FIn(S)>::type;
+    using WrapperT = AddDefaultReturnValueWrapper<F,ObserverAction,ObserverAction::next>;
+
+    // If return value of passed function is void, add ObserverAction::next as
+    // default return value.
+    using NodeT = typename std::conditional<
+        std::is_same<void,R>::value,
+        AsyncSignalObserverNode<D,S,WrapperT>,
+        AsyncSignalObserverNode<D,S,F>
+            >::type;
+
+    const auto& subjectPtr = GetNodePtr(subject);
+
+    std::unique_ptr<ObserverNode<D>> nodePtr(
+        new NodeT(subjectPtr, executor, std::forward<FIn>(func)) );
+    ObserverNode<D>* rawNodePtr = nodePtr.get();
+
+    subjectPtr->RegisterObserver(std::move(nodePtr));
+
+    return Observer<D>( rawNodePtr, subjectPtr );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Observe - Events
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -203,6 +203,62 @@ auto MakeSignal(const SignalPack<D,TValues...>& argPack, FIn&& func)
         argPack.Data);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Stage - Step of a static graph, reading the slots Is...
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template
+<
+    size_t ... Is,
+    typename FIn,
+    typename F = typename std::decay<FIn>::type
+>
+auto Stage(FIn&& func)
+    -> REACT_IMPL::StaticStage<F,Is...>
+{
+    return REACT_IMPL::StaticStage<F,Is...>( std::forward<FIn>(func) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// MakeStaticSignal
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Compiles a fixed graph into a single node.
+// Slots 0..N-1 are the signals of the pack, each stage adds the next slot and the last stage
+// computes the value of the signal.
+template
+<
+    typename D,
+    typename ... TValues,
+    typename ... TStages,
+    typename TSlots = typename REACT_IMPL::StaticSlotTypes<
+        std::tuple<TValues...>, TStages...>::Type,
+    typename S = typename std::tuple_element<
+        std::tuple_size<TSlots>::value - 1, TSlots>::type,
+    typename TOp = REACT_IMPL::StaticGraphOp<S, std::tuple<TStages...>,
+        REACT_IMPL::SignalNodePtrT<D,TValues> ...>
+>
+auto MakeStaticSignal(const SignalPack<D,TValues...>& argPack, TStages ... stages)
+    -> TempSignal<D,S,TOp>
+{
+    using REACT_IMPL::SignalOpNode;
+
+    struct NodeBuilder_
+    {
+        auto operator()(const Signal<D,TValues>& ... args)
+            -> TempSignal<D,S,TOp>
+        {
+            return TempSignal<D,S,TOp>(
+                std::make_shared<SignalOpNode<D,S,TOp>>(
+                    std::move(MyStages), GetNodePtr(args) ...));
+        }
+
+        std::tuple<TStages...>  MyStages;
+    };
+
+    return REACT_IMPL::apply(
+        NodeBuilder_{ std::tuple<TStages...>( std::move(stages) ...) },
+        argPack.Data);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// Unary operators
 ///////////////////////////////////////////////////////////////////////////////////////////////////
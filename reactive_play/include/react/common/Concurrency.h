@@ -12,7 +12,11 @@
 #include "react/detail/Defs.h"
 
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "react/common/RefCounting.h"
 
@@ -290,6 +294,91 @@ private:
     bool    blocked_ = false;
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// IExecutor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class IExecutor
+{
+public:
+    virtual inline ~IExecutor() {}
+
+    virtual void Post(std::function<void()>&& work) = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// ThreadPoolExecutor
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Posted work is run by a fixed number of worker threads that share a single queue.
+// With one thread (the default), it acts as a single-consumer queue and runs work in order.
+class ThreadPoolExecutor : public IExecutor
+{
+public:
+    explicit inline ThreadPoolExecutor(size_t threadCount = 1)
+    {
+        workers_.reserve(threadCount);
+
+        for (size_t i = 0; i < threadCount; ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    // Deleted copy ctor & assignment
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    // Runs remaining work before joining the workers
+    inline ~ThreadPoolExecutor()
+    {
+        {// mutex_
+            std::lock_guard<std::mutex> scopedLock(mutex_);
+            isStopped_ = true;
+        }// ~mutex_
+
+        condition_.notify_all();
+
+        for (auto& t : workers_)
+            t.join();
+    }
+
+    virtual inline void Post(std::function<void()>&& work) override
+    {
+        {// mutex_
+            std::lock_guard<std::mutex> scopedLock(mutex_);
+            queue_.push_back(std::move(work));
+        }// ~mutex_
+
+        condition_.notify_one();
+    }
+
+private:
+    inline void run()
+    {
+        while (true)
+        {
+            std::function<void()> work;
+
+            {// mutex_
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return isStopped_ || !queue_.empty(); });
+
+                if (queue_.empty())
+                    return;
+
+                work = std::move(queue_.front());
+                queue_.pop_front();
+            }// ~mutex_
+
+            work();
+        }
+    }
+
+    std::mutex                          mutex_;
+    std::condition_variable             condition_;
+    std::deque<std::function<void()>>   queue_;
+    std::vector<std::thread>            workers_;
+
+    bool    isStopped_ = false;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// ConditionalCriticalSection
 ///////////////////////////////////////////////////////////////////////////////////////////////////
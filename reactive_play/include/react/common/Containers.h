@@ -43,6 +43,8 @@ private:
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// NodeVector
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+// After a bulk attach, the nodes are kept in a range of a block shared with other vectors.
+// The range is only read; the first Add or Remove copies it into a vector of its own.
 template <typename TNode>
 class NodeVector
 {
@@ -52,25 +54,80 @@ private:
 public:
     void Add(TNode& node)
     {
+        ownData();
         data_.push_back(&node);
     }
 
     void Remove(const TNode& node)
     {
+        ownData();
         data_.erase(std::find(data_.begin(), data_.end(), &node));
     }
 
-    typedef typename DataT::iterator        iterator;
-    typedef typename DataT::const_iterator  const_iterator;
+    size_t Size() const
+    {
+        return block_ ? blockSize_ : data_.size();
+    }
+
+    // Bulk attach, first pass: counts a node that is going to be added.
+    // Returns true for the first node counted since the last MoveToBlock.
+    bool Reserve()
+    {
+        return ++reserved_ == 1;
+    }
+
+    bool IsReserved() const
+    {
+        return reserved_ != 0;
+    }
+
+    // Bulk attach, second pass: moves the nodes to the block at first, followed by room for
+    // the reserved ones. Returns the end of that room.
+    TNode** MoveToBlock(TNode** first)
+    {
+        const auto size = Size();
+
+        std::copy(begin(), end(), first);
+        data_ = DataT( );
 
-    iterator    begin() { return data_.begin(); }
-    iterator    end()   { return data_.end(); }
+        block_ = first;
+        blockSize_ = size;
 
-    const_iterator begin() const    { return data_.begin(); }
-    const_iterator end() const      { return data_.end(); }
+        auto last = first + size + reserved_;
+        reserved_ = 0;
+        return last;
+    }
+
+    // Bulk attach, second pass: adds a reserved node.
+    void AddToBlock(TNode& node)
+    {
+        block_[blockSize_++] = &node;
+    }
+
+    typedef TNode**         iterator;
+    typedef TNode* const*   const_iterator;
+
+    iterator    begin() { return block_ ? block_ : data_.data(); }
+    iterator    end()   { return block_ ? block_ + blockSize_ : data_.data() + data_.size(); }
+
+    const_iterator begin() const    { return block_ ? block_ : data_.data(); }
+    const_iterator end() const      { return block_ ? block_ + blockSize_ : data_.data() + data_.size(); }
 
 private:
-    DataT    data_;
+    void ownData()
+    {
+        if (block_ == nullptr)
+            return;
+
+        data_.assign(block_, block_ + blockSize_);
+        block_ = nullptr;
+        blockSize_ = 0;
+    }
+
+    DataT       data_;
+    TNode**     block_      = nullptr;
+    size_t      blockSize_  = 0;
+    size_t      reserved_   = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1,4 +1,3 @@
-
 //          Copyright Sebastian Jeckel 2014.
 // Distributed under the Boost Software License, Version 1.0.
 //    (See accompanying file LICENSE_1_0.txt or copy at
@@ -12,6 +11,8 @@
 #include "react/detail/Defs.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
 #include "tbb/queuing_mutex.h"
@@ -21,115 +22,185 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// SourceIdSet
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-template <typename T>
+// Ids below word_count * 64 are kept in a fixed-width atomic bitset, so inserts, merges and
+// intersection checks on them are word-parallel and lock-free.
+// Larger ids go to a sorted vector that is guarded by a mutex.
+// Key the set on IInputNode::SourceIndex() rather than on the ObjectId of the input nodes:
+// ObjectIds are node addresses and would all end up in the sparse vector.
+template <typename T, size_t word_count = 8>
 class SourceIdSet
 {
 private:
     using MutexT    = tbb::queuing_mutex;
-    using DataT     = std::vector<T>;
+    using WordT     = uint64_t;
+    using SparseT   = std::vector<T>;
+
+    static const size_t bits_per_word = 64;
+    static const size_t dense_id_count = word_count * bits_per_word;
 
 public:
-    void Insert(const T& e)
+    SourceIdSet()
     {
-        MutexT::scoped_lock lock(mutex_);
-
-        data_.push_back(e);
-        
-        isSorted_ = false;
+        for (auto& w : words_)
+            w.store(0, std::memory_order_relaxed);
     }
 
-    void Insert(SourceIdSet<T>& other)
+    // Deleted copy ctor & assignment
+    SourceIdSet(const SourceIdSet&) = delete;
+    SourceIdSet& operator=(const SourceIdSet&) = delete;
+
+    void Insert(const T& e)
     {
-        MutexT::scoped_lock myLock(mutex_);
-        MutexT::scoped_lock otherLock(other.mutex_);
+        const auto id = static_cast<size_t>(e);
 
-        sort();
-        other.sort();
+        if (id < dense_id_count)
+        {
+            words_[id / bits_per_word].fetch_or(mask(id), std::memory_order_relaxed);
+        }
+        else
+        {// mutex_
+            MutexT::scoped_lock lock(mutex_);
 
-        auto l = data_.begin();
-        auto r = data_.end();
-        auto offset = std::distance(l,r);
+            auto it = std::lower_bound(sparse_.begin(), sparse_.end(), e);
+            if (it == sparse_.end() || *it != e)
+                sparse_.insert(it, e);
+
+            hasSparse_.store(true, std::memory_order_relaxed);
+        }// ~mutex_
+    }
 
-        // For each element in other, check if it's already contained in this
-        // if not, add it
-        for (const auto& e : other.data_)
+    void Insert(const SourceIdSet& other)
+    {
+        for (size_t i = 0; i < word_count; ++i)
         {
-            l = std::lower_bound(l, r, e);
+            const auto w = other.words_[i].load(std::memory_order_relaxed);
+            if (w != 0)
+                words_[i].fetch_or(w, std::memory_order_relaxed);
+        }
 
-            // Already in the set?
-            if (l < r && *l == e)
-                continue;
+        if (!other.hasSparse_.load(std::memory_order_relaxed) || &other == this)
+            return;
 
-            auto d = std::distance(data_.begin(), l);
+        // Copy first, so the two mutexes are never held at the same time
+        SparseT otherSparse;
 
-            data_.push_back(e);
+        {// other.mutex_
+            MutexT::scoped_lock otherLock(other.mutex_);
+            otherSparse = other.sparse_;
+        }// ~other.mutex_
 
-            // push_back invalidates iterators
-            l = data_.begin() + d;
-            r = data_.begin() + offset; 
-        }
+        {// mutex_
+            MutexT::scoped_lock lock(mutex_);
+
+            auto offset = sparse_.size();
+            sparse_.insert(sparse_.end(), otherSparse.begin(), otherSparse.end());
 
-        std::inplace_merge(data_.begin(), data_.begin() + offset, data_.end());
+            std::inplace_merge(sparse_.begin(), sparse_.begin() + offset, sparse_.end());
+            sparse_.erase(std::unique(sparse_.begin(), sparse_.end()), sparse_.end());
+
+            hasSparse_.store(!sparse_.empty(), std::memory_order_relaxed);
+        }// ~mutex_
     }
 
     void Erase(const T& e)
     {
-        MutexT::scoped_lock lock(mutex_);
+        const auto id = static_cast<size_t>(e);
 
-        data_.erase(std::find(data_.begin(), data_.end(), e));
-    }
+        if (id < dense_id_count)
+        {
+            words_[id / bits_per_word].fetch_and(~mask(id), std::memory_order_relaxed);
+        }
+        else
+        {// mutex_
+            MutexT::scoped_lock lock(mutex_);
 
-    void Clear()
-    {
-        MutexT::scoped_lock lock(mutex_);
+            auto it = std::lower_bound(sparse_.begin(), sparse_.end(), e);
+            if (it != sparse_.end() && *it == e)
+                sparse_.erase(it);
 
-        data_.clear();
-        isSorted_ = true;
+            hasSparse_.store(!sparse_.empty(), std::memory_order_relaxed);
+        }// ~mutex_
     }
 
-    bool IntersectsWith(SourceIdSet<T>& other)
+    void Clear()
     {
-        MutexT::scoped_lock myLock(mutex_);
-        MutexT::scoped_lock otherLock(other.mutex_);
+        for (auto& w : words_)
+            w.store(0, std::memory_order_relaxed);
 
-        sort();
-        other.sort();
+        if (!hasSparse_.load(std::memory_order_relaxed))
+            return;
 
-        auto l1 = data_.begin();
-        const auto r1 = data_.end();
+        {// mutex_
+            MutexT::scoped_lock lock(mutex_);
 
-        auto l2 = other.data_.begin();
-        const auto r2 = other.data_.end();
+            sparse_.clear();
+            hasSparse_.store(false, std::memory_order_relaxed);
+        }// ~mutex_
+    }
 
-        // Is intersection of turn sourceIds and node sourceIds non-empty?
-        while (l1 != r1 && l2 != r2)
+    bool IntersectsWith(const SourceIdSet& other) const
+    {
+        for (size_t i = 0; i < word_count; ++i)
         {
-            if (*l1 < *l2)
-                l1++;
-            else if (*l2 < *l1)
-                l2++;
-            // Equals => Intersect 
-            else
+            const auto w = words_[i].load(std::memory_order_relaxed)
+                & other.words_[i].load(std::memory_order_relaxed);
+
+            if (w != 0)
                 return true;
         }
+
+        if (!hasSparse_.load(std::memory_order_relaxed)
+            || !other.hasSparse_.load(std::memory_order_relaxed))
+            return false;
+
+        if (&other == this)
+            return true;
+
+        SparseT otherSparse;
+
+        {// other.mutex_
+            MutexT::scoped_lock otherLock(other.mutex_);
+            otherSparse = other.sparse_;
+        }// ~other.mutex_
+
+        {// mutex_
+            MutexT::scoped_lock lock(mutex_);
+
+            auto l1 = sparse_.begin();
+            const auto r1 = sparse_.end();
+
+            auto l2 = otherSparse.begin();
+            const auto r2 = otherSparse.end();
+
+            // Is intersection of turn sourceIds and node sourceIds non-empty?
+            while (l1 != r1 && l2 != r2)
+            {
+                if (*l1 < *l2)
+                    l1++;
+                else if (*l2 < *l1)
+                    l2++;
+                // Equals => Intersect
+                else
+                    return true;
+            }
+        }// ~mutex_
+
         return false;
     }
 
 private:
-    MutexT  mutex_;
-    DataT   data_;
-    bool    isSorted_ = false;
-
-    void sort()
+    static WordT mask(size_t id)
     {
-        if (isSorted_)
-            return;
-        
-        std::sort(data_.begin(), data_.end());
-        isSorted_ = true;
+        return WordT(1) << (id % bits_per_word);
     }
+
+    std::atomic<WordT>  words_[word_count];
+    std::atomic<bool>   hasSparse_{ false };
+
+    mutable MutexT  mutex_;
+    SparseT         sparse_;
 };
 
 /****************************************/ REACT_IMPL_END /***************************************/
 
-#endif // REACT_COMMON_SOURCEIDSET_H_INCLUDED
\ No newline at end of file
+#endif // REACT_COMMON_SOURCEIDSET_H_INCLUDED
@@ -0,0 +1,71 @@
+//          Copyright Sebastian Jeckel 2014.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef REACT_COMMON_SOURCEINDEX_H_INCLUDED
+#define REACT_COMMON_SOURCEINDEX_H_INCLUDED
+
+#pragma once
+
+#include "react/detail/Defs.h"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+/***************************************/ REACT_IMPL_BEGIN /**************************************/
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// SourceIndexPool
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Hands out small indices for input nodes, as an alternative to their ObjectId, which is a
+// node address. Released indices are reused lowest first, so the indices of the live input
+// nodes stay close to 0 and fit the dense part of a SourceIdSet.
+class SourceIndexPool
+{
+public:
+    static SourceIndexPool& Instance()
+    {
+        static SourceIndexPool instance;
+        return instance;
+    }
+
+    SourceIndexPool() = default;
+
+    // Deleted copy ctor & assignment
+    SourceIndexPool(const SourceIndexPool&) = delete;
+    SourceIndexPool& operator=(const SourceIndexPool&) = delete;
+
+    size_t Acquire()
+    {
+        std::lock_guard<std::mutex> scopedLock(mutex_);
+
+        if (free_.empty())
+            return next_++;
+
+        auto index = free_.top();
+        free_.pop();
+        return index;
+    }
+
+    void Release(size_t index)
+    {
+        std::lock_guard<std::mutex> scopedLock(mutex_);
+
+        free_.push(index);
+    }
+
+private:
+    using FreeQueueT = std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>>;
+
+    std::mutex  mutex_;
+    FreeQueueT  free_;
+    size_t      next_ = 0;
+};
+
+/****************************************/ REACT_IMPL_END /***************************************/
+
+#endif // REACT_COMMON_SOURCEINDEX_H_INCLUDED
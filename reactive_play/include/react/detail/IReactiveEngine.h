@@ -49,6 +49,10 @@ struct IReactiveEngine
 
     void OnDynamicNodeAttach(NodeT& node, NodeT& parent, TurnT& turn)    {}
     void OnDynamicNodeDetach(NodeT& node, NodeT& parent, TurnT& turn)    {}
+
+    // Engines may defer the attaches between these calls and apply them at once.
+    void OnBulkAttachBegin()    {}
+    void OnBulkAttachEnd()      {}
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -147,6 +151,16 @@ struct EngineInterface
             GetObjectId(node), GetObjectId(parent), turn.Id()));
         Instance().OnDynamicNodeDetach(node, parent, turn);
     }
+
+    static void OnBulkAttachBegin()
+    {
+        Instance().OnBulkAttachBegin();
+    }
+
+    static void OnBulkAttachEnd()
+    {
+        Instance().OnBulkAttachEnd();
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
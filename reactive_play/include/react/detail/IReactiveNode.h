@@ -11,6 +11,10 @@
 
 #include "react/detail/Defs.h"
 
+#include <cstddef>
+
+#include "react/common/SourceIndex.h"
+
 /***************************************/ REACT_IMPL_BEGIN /**************************************/
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -50,9 +54,22 @@ struct IReactiveNode
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 struct IInputNode
 {
-    virtual ~IInputNode() = default;
+    IInputNode() :
+        sourceIndex_( SourceIndexPool::Instance().Acquire() )
+    {}
+
+    virtual ~IInputNode()
+    {
+        SourceIndexPool::Instance().Release(sourceIndex_);
+    }
 
     virtual bool ApplyInput(void* turnPtr) = 0;
+
+    // Small index that is unique among the live input nodes, to key a SourceIdSet on.
+    size_t SourceIndex() const  { return sourceIndex_; }
+
+private:
+    size_t  sourceIndex_;
 };
 
 /****************************************/ REACT_IMPL_END /***************************************/
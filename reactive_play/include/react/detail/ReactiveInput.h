@@ -85,6 +85,74 @@ struct ThreadLocalInputState
 template <typename T>
 REACT_TLS bool ThreadLocalInputState<T>::IsTransactionActive(false);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// ContinuationBatcher
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Groups continuations by target, so each target domain receives a single async transaction
+// per turn that runs all of its continuations in the order they were stored.
+// The merged transaction only allows merging if all of its parts do.
+class ContinuationBatcher
+{
+    struct Batch_
+    {
+        Batch_(IContinuationTarget* target, TransactionFlagsT flags) :
+            Target( target ),
+            Flags( flags )
+        {}
+
+        IContinuationTarget*            Target;
+        TransactionFlagsT               Flags;
+        std::vector<TransactionFuncT>   Funcs;
+    };
+
+    using FuncVectT = std::vector<TransactionFuncT>;
+
+public:
+    void Add(IContinuationTarget* target, TransactionFlagsT flags, TransactionFuncT&& func)
+    {
+        // Few distinct targets per turn, a linear search is fine
+        for (auto& b : batches_)
+        {
+            if (b.Target == target)
+            {
+                b.Flags &= flags;
+                b.Funcs.push_back(std::move(func));
+                return;
+            }
+        }
+
+        batches_.emplace_back(target, flags);
+        batches_.back().Funcs.push_back(std::move(func));
+    }
+
+    void Dispatch(const WaitingStatePtrT& waitingStatePtr)
+    {
+        for (auto& b : batches_)
+        {
+            if (b.Funcs.size() == 1)
+            {
+                b.Target->AsyncContinuation(b.Flags, waitingStatePtr, std::move(b.Funcs[0]));
+            }
+            else
+            {
+                // TransactionFuncT must be copyable, so share the batch
+                auto funcsPtr = std::make_shared<FuncVectT>(std::move(b.Funcs));
+
+                b.Target->AsyncContinuation(b.Flags, waitingStatePtr, [funcsPtr]
+                    {
+                        for (auto& f : *funcsPtr)
+                            f();
+                    });
+            }
+        }
+
+        batches_.clear();
+    }
+
+private:
+    std::vector<Batch_>     batches_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// ContinuationManager
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -114,7 +182,7 @@ class ContinuationManager<sequential_propagation>
         Data_(IContinuationTarget* target, TransactionFlagsT flags, TransactionFuncT&& func) :
             Target( target ),
             Flags( flags ),
-            Func( func )
+            Func( std::move(func) )
         {}
 
         IContinuationTarget*    Target;
@@ -140,9 +208,11 @@ public:
     void StartContinuations(const WaitingStatePtrT& waitingStatePtr)
     {
         for (auto& t : storedContinuations_)
-            t.Target->AsyncContinuation(t.Flags, waitingStatePtr, std::move(t.Func));
+            batcher_.Add(t.Target, t.Flags, std::move(t.Func));
 
         storedContinuations_.clear();
+
+        batcher_.Dispatch(waitingStatePtr);
     }
 
     // Todo: Move this somewhere else
@@ -160,8 +230,9 @@ public:
     }
 
 private:
-    DataVectT   storedContinuations_;
-    ObsVectT    detachedObservers_;
+    DataVectT           storedContinuations_;
+    ObsVectT            detachedObservers_;
+    ContinuationBatcher batcher_;
 };
 
 // Thread-safe implementation
@@ -173,7 +244,7 @@ class ContinuationManager<parallel_propagation>
         Data_(IContinuationTarget* target, TransactionFlagsT flags, TransactionFuncT&& func) :
             Target( target ),
             Flags( flags ),
-            Func( func )
+            Func( std::move(func) )
         {}
 
         IContinuationTarget*    Target;
@@ -189,22 +260,28 @@ public:
                            TransactionFuncT&& cont)
     {
         storedContinuations_.local().emplace_back(&target, flags, std::move(cont));
-        ++contCount_;
+        contCount_.fetch_add(1, std::memory_order_relaxed);
     }
 
     bool HasContinuations() const
     {
-        return contCount_ != 0;
+        return contCount_.load(std::memory_order_relaxed) != 0;
     }
 
+    // Called after propagation, when no more continuations are being stored
     void StartContinuations(const WaitingStatePtrT& waitingStatePtr)
     {
+        // Keep the thread-local vectors and their capacity for the next turn
         for (auto& v : storedContinuations_)
+        {
             for (auto& t : v)
-                t.Target->AsyncContinuation(t.Flags, waitingStatePtr, std::move(t.Func));
+                batcher_.Add(t.Target, t.Flags, std::move(t.Func));
+            v.clear();
+        }
 
-        storedContinuations_.clear();
-        contCount_ = 0;
+        contCount_.store(0, std::memory_order_relaxed);
+
+        batcher_.Dispatch(waitingStatePtr);
     }
 
     void QueueObserverForDetach(IObserver& obs)
@@ -226,8 +303,9 @@ public:
 private:
     tbb::enumerable_thread_specific<DataVecT>   storedContinuations_;
     tbb::enumerable_thread_specific<ObsVectT>   detachedObservers_;
+    ContinuationBatcher                         batcher_;
 
-    size_t contCount_ = 0;
+    std::atomic<size_t> contCount_{ 0 };
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
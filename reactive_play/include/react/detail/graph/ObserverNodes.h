@@ -11,11 +11,14 @@
 
 #include "react/detail/Defs.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "GraphBase.h"
 
+#include "react/common/Concurrency.h"
 #include "react/detail/ReactiveInput.h"
 
 /***************************************/ REACT_IMPL_BEGIN /**************************************/
@@ -167,6 +170,167 @@ private:
     TFunc                           func_;
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// AsyncSignalObserverNode
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Hands the observer call off to an executor instead of running it during propagation.
+// Values that arrive while a delivery is still pending are coalesced, so the observer
+// only sees the latest one. Calls to the observer never overlap.
+// Detaching or destroying the node stops pending deliveries, but a call that has already
+// started still runs to completion.
+template
+<
+    typename D,
+    typename S,
+    typename TFunc
+>
+class AsyncSignalObserverNode :
+    public ObserverNode<D>
+{
+    using Engine = typename AsyncSignalObserverNode::Engine;
+
+    // Shared with pending deliveries, which may outlive the node
+    struct State_
+    {
+        template <typename F>
+        State_(F&& func, const S& value) :
+            Func( std::forward<F>(func) ),
+            Latest( value )
+        {}
+
+        TFunc               Func;
+        S                   Latest;
+        std::mutex          Mutex;
+        bool                HasValue    = false;
+        bool                IsScheduled = false;
+        std::atomic<bool>   IsStopped{ false };
+    };
+
+    using StatePtrT = std::shared_ptr<State_>;
+
+public:
+    template <typename F>
+    AsyncSignalObserverNode(const std::shared_ptr<SignalNode<D,S>>& subject,
+                            IExecutor& executor, F&& func) :
+        AsyncSignalObserverNode::ObserverNode( ),
+        subject_( subject ),
+        executor_( executor ),
+        statePtr_( std::make_shared<State_>(std::forward<F>(func), subject->ValueRef()) )
+    {
+        Engine::OnNodeCreate(*this);
+        Engine::OnNodeAttach(*this, *subject);
+    }
+
+    ~AsyncSignalObserverNode()
+    {
+        statePtr_->IsStopped.store(true, std::memory_order_release);
+        Engine::OnNodeDestroy(*this);
+    }
+
+    virtual const char* GetNodeType() const override        { return "AsyncSignalObserverNode"; }
+    virtual int         DependencyCount() const override    { return 1; }
+
+    virtual void Tick(void* turnPtr) override
+    {
+#ifdef REACT_ENABLE_LOGGING
+        using TurnT = typename D::Engine::TurnT;
+        TurnT& turn = *reinterpret_cast<TurnT*>(turnPtr);
+#endif
+
+        REACT_LOG(D::Log().template Append<NodeEvaluateBeginEvent>(
+            GetObjectId(*this), turn.Id()));
+
+        // The observer asked to be detached during an earlier delivery
+        bool shouldDetach = statePtr_->IsStopped.load(std::memory_order_acquire);
+
+        if (auto p = subject_.lock())
+        {
+            if (!shouldDetach)
+            {
+                bool shouldPost = false;
+
+                {// timer
+                    using TimerT = typename AsyncSignalObserverNode::ScopedUpdateTimer;
+                    TimerT scopedTimer( *this, 1 );
+
+                    {// Mutex
+                        std::lock_guard<std::mutex> scopedLock(statePtr_->Mutex);
+
+                        statePtr_->Latest = p->ValueRef();
+                        statePtr_->HasValue = true;
+
+                        shouldPost = !statePtr_->IsScheduled;
+                        statePtr_->IsScheduled = true;
+                    }// ~Mutex
+                }// ~timer
+
+                // Only one delivery is pending at any time, it picks up the latest value
+                if (shouldPost)
+                {
+                    StatePtrT statePtr = statePtr_;
+                    executor_.Post([statePtr] { deliver(*statePtr); });
+                }
+            }
+        }
+
+        if (shouldDetach)
+            DomainSpecificInputManager<D>::Instance()
+                .QueueObserverForDetach(*this);
+
+        REACT_LOG(D::Log().template Append<NodeEvaluateEndEvent>(
+            GetObjectId(*this), turn.Id()));
+    }
+
+    virtual void UnregisterSelf() override
+    {
+        if (auto p = subject_.lock())
+            p->UnregisterObserver(this);
+    }
+
+private:
+    static void deliver(State_& state)
+    {
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(state.Mutex);
+
+            // Nothing new arrived during the last call
+            if (!state.HasValue)
+            {
+                state.IsScheduled = false;
+                return;
+            }
+
+            S value( std::move(state.Latest) );
+            state.HasValue = false;
+
+            lock.unlock();
+
+            if (state.IsStopped.load(std::memory_order_acquire))
+                continue;
+
+            if (state.Func(value) == ObserverAction::stop_and_detach)
+                state.IsStopped.store(true, std::memory_order_release);
+        }
+    }
+
+    virtual void detachObserver() override
+    {
+        // Deliveries already posted to the executor must not call Func anymore
+        statePtr_->IsStopped.store(true, std::memory_order_release);
+
+        if (auto p = subject_.lock())
+        {
+            Engine::OnNodeDetach(*this, *p);
+            subject_.reset();
+        }
+    }
+
+    std::weak_ptr<SignalNode<D,S>>  subject_;
+    IExecutor&                      executor_;
+    StatePtrT                       statePtr_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// EventObserverNode
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -308,7 +472,7 @@ public:
                 using TimerT = typename SyncedObserverNode::ScopedUpdateTimer;
                 TimerT scopedTimer( *this, p->Events().size() );
             
-                shouldDetach = apply(
+                shouldDetach = REACT_IMPL::apply(
                     [this, &p] (const std::shared_ptr<SignalNode<D,TDepValues>>& ... args)
                     {
                         return func_(EventRange<E>( p->Events() ), args->ValueRef() ...);
@@ -346,7 +510,7 @@ private:
         {
             Engine::OnNodeDetach(*this, *p);
 
-            apply(
+            REACT_IMPL::apply(
                 DetachFunctor<D,SyncedObserverNode,
                     std::shared_ptr<SignalNode<D,TDepValues>>...>( *this ),
                 deps_);
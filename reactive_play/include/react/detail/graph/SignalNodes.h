@@ -12,6 +12,8 @@
 #include "react/detail/Defs.h"
 
 #include <memory>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "GraphBase.h"
@@ -189,7 +191,7 @@ public:
 
     S Evaluate() 
     {
-        return apply(EvalFunctor( func_ ), this->deps_);
+        return REACT_IMPL::apply(EvalFunctor( func_ ), this->deps_);
     }
 
 private:
@@ -223,6 +225,150 @@ private:
     F   func_;
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// StaticStage
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// One step of a static graph.
+// Is... index the slots it reads; slots are the graph inputs followed by the results of all
+// previous stages, so the declaration order is the topological order.
+template
+<
+    typename F,
+    size_t ... Is
+>
+class StaticStage
+{
+public:
+    template <typename ... TSlots>
+    using ResultT = typename std::decay<
+        decltype(std::declval<F&>()(
+            std::declval<const typename std::tuple_element<Is, std::tuple<TSlots...>>::type&>() ...))>::type;
+
+    template <typename FIn>
+    explicit StaticStage(FIn&& func) :
+        func_( std::forward<FIn>(func) )
+    {}
+
+    template <typename ... TSlots>
+    ResultT<TSlots...> Invoke(const TSlots& ... slots)
+    {
+        return func_(std::get<Is>(std::forward_as_tuple(slots ...)) ...);
+    }
+
+private:
+    F   func_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// StaticSlotTypes - Value types of all slots after the given stages
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TSlots, typename ... TStages>
+struct StaticSlotTypes;
+
+template <typename ... TSlots>
+struct StaticSlotTypes<std::tuple<TSlots...>>
+{
+    using Type = std::tuple<TSlots...>;
+};
+
+template <typename ... TSlots, typename TStage, typename ... TStages>
+struct StaticSlotTypes<std::tuple<TSlots...>, TStage, TStages...> :
+    public StaticSlotTypes<
+        std::tuple<TSlots..., typename TStage::template ResultT<TSlots...>>, TStages...>
+{};
+
+template <size_t N, typename ... TStages>
+struct StaticStageCheck : std::true_type {};
+
+template <size_t N, typename F, size_t ... Is, typename ... TStages>
+struct StaticStageCheck<N, StaticStage<F,Is...>, TStages...>
+{
+    static const bool value = (true && ... && (Is < N))
+        && StaticStageCheck<N+1, TStages...>::value;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// StaticGraphOp
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Evaluates all stages of a static graph in a single pass.
+// Intermediate results are passed down as const references, so there is no per-stage node,
+// no virtual dispatch and no engine scheduling between stages.
+template
+<
+    typename S,
+    typename TStages,
+    typename ... TDeps
+>
+class StaticGraphOp;
+
+template
+<
+    typename S,
+    typename ... TStages,
+    typename ... TDeps
+>
+class StaticGraphOp<S,std::tuple<TStages...>,TDeps...> : public ReactiveOpBase<TDeps...>
+{
+    static const size_t stage_count = sizeof...(TStages);
+
+    static_assert(stage_count > 0, "StaticGraphOp requires at least one stage.");
+    static_assert(StaticStageCheck<sizeof...(TDeps), TStages...>::value,
+        "A stage may only read inputs and results of earlier stages.");
+
+public:
+    template <typename ... TDepsIn>
+    StaticGraphOp(std::tuple<TStages...>&& stages, TDepsIn&& ... deps) :
+        StaticGraphOp::ReactiveOpBase( DontMove(), std::forward<TDepsIn>(deps) ... ),
+        stages_( std::move(stages) )
+    {}
+
+    StaticGraphOp(StaticGraphOp&& other) :
+        StaticGraphOp::ReactiveOpBase( std::move(other) ),
+        stages_( std::move(other.stages_) )
+    {}
+
+    S Evaluate()
+    {
+        return REACT_IMPL::apply(EvalFunctor{ *this }, this->deps_);
+    }
+
+private:
+    struct EvalFunctor
+    {
+        template <typename ... T>
+        S operator()(T&& ... args)
+        {
+            return Self.template evalStage<0>(eval(args) ...);
+        }
+
+        template <typename T>
+        static auto eval(T& op) -> decltype(op.Evaluate())
+        {
+            return op.Evaluate();
+        }
+
+        template <typename T>
+        static auto eval(const std::shared_ptr<T>& depPtr) -> decltype(depPtr->ValueRef())
+        {
+            return depPtr->ValueRef();
+        }
+
+        StaticGraphOp& Self;
+    };
+
+    // Each stage appends its result as a new slot for the stages after it
+    template <size_t K, typename ... TSlots>
+    S evalStage(const TSlots& ... slots)
+    {
+        if constexpr (K + 1 == stage_count)
+            return std::get<K>(stages_).Invoke(slots ...);
+        else
+            return evalStage<K+1>(slots ..., std::get<K>(stages_).Invoke(slots ...));
+    }
+
+    std::tuple<TStages...>  stages_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// SignalOpNode
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 #include "react/detail/Defs.h"
 
 #include <atomic>
+#include <memory>
 #include <utility>
 #include <type_traits>
 #include <vector>
@@ -114,6 +115,10 @@ struct GetWeightFunctor
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /// EngineBase
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+// During a bulk attach, attaches are only recorded. At the end, levels are computed in one
+// pass over the recorded edges, which are in topological order because nodes are attached
+// after their parents, and the successors of all parents are stored in one block.
+// Blocks are kept until the engine is destroyed.
 template <typename TNode, typename TTurn>
 class EngineBase : public IReactiveEngine<TNode,TTurn>
 {
@@ -124,8 +129,18 @@ public:
     void OnInputChange(TNode& node, TTurn& turn);
     void OnNodePulse(TNode& node, TTurn& turn);
 
+    void OnBulkAttachBegin();
+    void OnBulkAttachEnd();
+
 protected:
     virtual void processChildren(TNode& node, TTurn& turn) = 0;
+
+private:
+    using EdgeT = std::pair<TNode*,TNode*>;
+
+    bool                                isBulkAttach_ = false;
+    vector<EdgeT>                       bulkEdges_;
+    vector<std::unique_ptr<TNode*[]>>   successorBlocks_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
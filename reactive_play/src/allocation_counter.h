@@ -0,0 +1,33 @@
+#pragma once
+
+/*
+ * Counts the heap allocations made by a play, and the bytes they request, by
+ * replacing the global operator new and delete. Include it from one file only:
+ * every play is its own program
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations { 0 };
+static std::atomic<size_t> allocated_bytes { 0 };
+
+/* malloc(0) may return null, which must not be reported as a failure */
+static void* counted_allocate(size_t size) {
+  ++allocations;
+  allocated_bytes += size;
+  if(auto p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc { };
+}
+
+static void counted_free(void* p) noexcept { std::free(p); }
+
+void* operator new(size_t size) { return counted_allocate(size); }
+void* operator new[](size_t size) { return counted_allocate(size); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, size_t) noexcept { counted_free(p); }
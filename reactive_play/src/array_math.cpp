@@ -0,0 +1,111 @@
+/*
+ * Elementwise expressions over arrays of sensor readings
+ *
+ * Observable values hold 4096 floats. We compare the elementwise operators and
+ * math filters with hand-written filters that loop over the arrays one element
+ * at a time: a sum, which is vectorized, and a sine over readings where only 8
+ * elements change per update, which only recomputes the changed elements. Both
+ * run again with 8 changed elements set through set_lanes(), so neither the
+ * value nor the expressions compare or copy the whole array
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static size_t const LANE_COUNT = 4096;
+static size_t const CHANGED_LANES = 8;
+static unsigned long const UPDATE_COUNT = 2'000;
+
+using readings = std::vector<float>;
+
+struct loop_add {
+  auto operator()(const readings& a, const readings& b) const {
+    readings result(a.size());
+    for(size_t i = 0; i < a.size(); ++i)
+      result[i] = a[i] + b[i];
+    return result;
+  }
+};
+
+struct loop_sin {
+  auto operator()(const readings& a) const {
+    readings result(a.size());
+    for(size_t i = 0; i < a.size(); ++i)
+      result[i] = std::sin(a[i]);
+    return result;
+  }
+};
+
+OBSERVABLE_ADAPT_FILTER(loop_add_, loop_add { })
+OBSERVABLE_ADAPT_FILTER(loop_sin_, loop_sin { })
+
+template <typename Make>
+auto run(Make make, size_t changed_lanes, bool set_lanes = false) {
+  observable::value<readings> a { readings(LANE_COUNT, 1.0f) };
+  observable::value<readings> b { readings(LANE_COUNT, 2.0f) };
+  auto result = observable::observe(make(a, b));
+
+  auto next = a.get();
+  std::vector<size_t> indices(changed_lanes);
+  readings values(changed_lanes);
+  size_t update = 0;
+  return time_run(
+    [&]() {
+      ++update;
+      for(size_t i = 0; i < changed_lanes; ++i) {
+        indices[i] = (update * changed_lanes + i) % LANE_COUNT;
+        values[i] = static_cast<float>(update);
+        next[indices[i]] = values[i];
+      }
+
+      if(set_lanes)
+        a.set_lanes(indices, values);
+      else
+        a = next;
+
+      consume(Foo(static_cast<int>(result.get()[0])));
+    }, UPDATE_COUNT);
+}
+
+void compare(const std::string& name,
+             std::chrono::nanoseconds loop_duration,
+             std::chrono::nanoseconds lanes_duration) {
+  print_duration("Observable " + name + " loop", loop_duration);
+  print_duration("Observable " + name + " lanes", lanes_duration);
+  print_duration_diff("Observable " + name + " lanes", lanes_duration,
+                      "Observable " + name + " loop", loop_duration);
+}
+
+int main() {
+
+  compare("add",
+          run([](auto& a, auto& b) { return loop_add_(a, b); }, LANE_COUNT),
+          run([](auto& a, auto& b) { return a + b; }, LANE_COUNT));
+
+  cout << endl;
+
+  compare("sin",
+          run([](auto& a, auto&) { return loop_sin_(a); }, CHANGED_LANES),
+          run([](auto& a, auto&) { return observable::sin(a); }, CHANGED_LANES));
+
+  cout << endl;
+
+  compare("add set_lanes",
+          run([](auto& a, auto& b) { return loop_add_(a, b); }, CHANGED_LANES, true),
+          run([](auto& a, auto& b) { return a + b; }, CHANGED_LANES, true));
+
+  cout << endl;
+
+  compare("sin set_lanes",
+          run([](auto& a, auto&) { return loop_sin_(a); }, CHANGED_LANES, true),
+          run([](auto& a, auto&) { return observable::sin(a); }, CHANGED_LANES, true));
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,80 @@
+/*
+ * A slow observer should not hold up propagation
+ *
+ * We attach an observer that takes 1 ms and measure how long each turn takes
+ * when it is called inline and when it is handed off to an executor
+ */
+
+#include <atomic>
+#include <thread>
+
+#include <react/react.h>
+
+#include "utility.h"
+
+static unsigned long const TURN_COUNT = 100;
+
+void slow_consume(Foo f) {
+  f();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+/** cpp react stuff */
+REACTIVE_DOMAIN(D, react::sequential)
+
+int main() {
+
+  /** Inline observer **/
+  react::VarSignal<D, Foo> sync_signal = react::MakeVar<D>(Foo());
+
+  react::Observe(sync_signal, slow_consume);
+
+  auto sync_i = 0;
+  const auto sync_duration = time_run(
+    [&sync_signal, &sync_i]() {
+      sync_signal <<= Foo(++sync_i);
+    }, TURN_COUNT);
+
+  print_duration("CppReact inline observer turn", sync_duration);
+
+  /** Observer on executor **/
+  std::atomic<int> delivered{0};
+  std::atomic<int> latest{0};
+
+  react::VarSignal<D, Foo> async_signal = react::MakeVar<D>(Foo());
+
+  {
+    react::ThreadPoolExecutor executor;
+
+    react::ScopedObserver<D> observer = react::Observe(async_signal, executor,
+      [&delivered, &latest](Foo f) {
+        slow_consume(f);
+        latest = f.getData();
+        ++delivered;
+      });
+
+    auto async_i = 0;
+    const auto async_duration = time_run(
+      [&async_signal, &async_i]() {
+        async_signal <<= Foo(++async_i);
+      }, TURN_COUNT);
+
+    print_duration("CppReact async observer turn", async_duration);
+
+    cout << endl;
+
+    print_duration_diff("CppReact async observer turn", async_duration,
+                        "CppReact inline observer turn", sync_duration);
+
+    // Destroying the observer drops the values it has not been called with
+    // yet, so wait for the last one while it is still attached
+    while(latest != int(TURN_COUNT))
+      std::this_thread::yield();
+  }
+
+  cout << "Turns: " << TURN_COUNT << ", async deliveries: " << delivered << endl;
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Expressions with 10 and 100 nodes, as a tree and compiled
+ *
+ * The expression is a chain, v0 * 1.0 * 0.5 + v1 * 0.5 + v2 ..., built with
+ * the expression operators. We change the deepest value, so every node on the
+ * way to the root has to be evaluated again, and read the result. The tree
+ * evaluates each node through its own std::function; the compiled expression
+ * evaluates the whole chain with a single loop over a flat arena
+ */
+
+#include <string>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static unsigned long const UPDATE_COUNT = 100'000;
+
+// Each link adds a constant, a value and two operators, so the chain has
+// 3 + 4 * links nodes.
+auto make_chain(std::vector<observable::value<double>>& values, size_t links) {
+  auto node = values[0] * 1.0;
+  for(size_t i = 1; i <= links; ++i)
+    node = std::move(node) * 0.5 + values[i];
+
+  return node;
+}
+
+void compare(size_t links) {
+  const auto node_count = std::to_string(3 + 4 * links);
+  std::vector<observable::value<double>> values(links + 1);
+
+  double i = 0;
+  const auto tree_duration = [&]() {
+    auto tree = observable::observe(make_chain(values, links));
+    return time_run(
+      [&]() {
+        values[0] = ++i;
+        consume(Foo(static_cast<int>(tree.get())));
+      }, UPDATE_COUNT);
+  }();
+
+  print_duration("Observable " + node_count + " node tree", tree_duration);
+
+  const auto compiled_duration = [&]() {
+    auto compiled = observable::observe(observable::compile(make_chain(values, links)));
+    return time_run(
+      [&]() {
+        values[0] = ++i;
+        consume(Foo(static_cast<int>(compiled.get())));
+      }, UPDATE_COUNT);
+  }();
+
+  print_duration("Observable " + node_count + " node compiled", compiled_duration);
+
+  print_duration_diff("Observable " + node_count + " node compiled", compiled_duration,
+                      "Observable " + node_count + " node tree", tree_duration);
+}
+
+int main() {
+
+  compare(2);
+  cout << endl;
+  compare(24);
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Readers and a writer sharing one observable value
+ *
+ * One writer keeps setting a value while 1, 2 and 4 readers keep reading it,
+ * for a fixed time. The value is either an observable::value guarded by a
+ * std::mutex or an observable::concurrent_value, which readers access without
+ * locking. Values are a small trivially copyable struct, kept behind a
+ * sequence lock, and a std::string, kept as an atomically swapped snapshot.
+ * The reported duration is the time taken by 1000 reads, across all readers
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static std::chrono::milliseconds const RUN_TIME { 100 };
+static unsigned const READER_COUNTS[] = { 1, 2, 4 };
+static unsigned long const READ_BATCH = 1000;
+
+struct position {
+  double x, y, z;
+  unsigned long frame;
+};
+
+inline auto make(position const*, unsigned long i) {
+  return position { i * 1.0, i * 2.0, i * 3.0, i };
+}
+
+inline auto make(std::string const*, unsigned long i) {
+  return std::string(32, static_cast<char>('a' + i % 26));
+}
+
+inline auto weight(position const& p) { return p.frame; }
+inline auto weight(std::string const& s) { return s.size() + static_cast<unsigned char>(s[0]); }
+
+template <typename ValueType>
+struct locked_value {
+  auto get() {
+    std::lock_guard<std::mutex> const lock { mutex };
+    return value.get();
+  }
+
+  void set(ValueType v) {
+    std::lock_guard<std::mutex> const lock { mutex };
+    value = std::move(v);
+  }
+
+  template <typename Observer>
+  auto subscribe(Observer observer) { return value.subscribe(std::move(observer)); }
+
+  std::mutex mutex;
+  observable::value<ValueType> value;
+};
+
+template <typename ValueType, typename Shared>
+auto run(Shared& shared, unsigned reader_count) {
+  std::atomic<bool> stop { false };
+  std::atomic<unsigned long> reads { 0 };
+  std::atomic<unsigned long> notified { 0 };
+
+  auto const sub = shared.subscribe([&]() { ++notified; });
+
+  std::vector<std::thread> readers;
+  for(auto r = 0u; r < reader_count; ++r)
+    readers.emplace_back([&]() {
+      auto count = 0ul;
+      auto checksum = 0ul;
+      while(!stop.load(std::memory_order_relaxed)) {
+        checksum += weight(shared.get());
+        ++count;
+      }
+      reads += count;
+      if(checksum == 0)
+        cout << "";
+    });
+
+  auto const start = std::chrono::high_resolution_clock::now();
+  auto writes = 0ul;
+  while(std::chrono::high_resolution_clock::now() - start < RUN_TIME) {
+    shared.set(make(static_cast<ValueType const*>(nullptr), ++writes));
+    std::this_thread::yield();
+  }
+
+  stop = true;
+  for(auto& r : readers)
+    r.join();
+
+  auto const elapsed = std::chrono::high_resolution_clock::now() - start;
+  if(notified != writes)
+    cout << "Missed notifications: " << writes - notified << endl;
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) * READ_BATCH
+         / std::max(reads.load(), 1ul);
+}
+
+template <typename ValueType>
+void compare(std::string const& type_name) {
+  for(auto readers : READER_COUNTS) {
+    auto const suffix = type_name + " " + std::to_string(readers) + " reader" + (readers > 1 ? "s" : "") + " 1000 reads";
+
+    locked_value<ValueType> locked;
+    const auto locked_duration = run<ValueType>(locked, readers);
+    print_duration("Observable mutex " + suffix, locked_duration);
+
+    observable::concurrent_value<ValueType> concurrent;
+    const auto concurrent_duration = run<ValueType>(concurrent, readers);
+    print_duration("Observable concurrent " + suffix, concurrent_duration);
+
+    print_duration_diff("Observable concurrent " + suffix, concurrent_duration,
+                        "Observable mutex " + suffix, locked_duration);
+    cout << endl;
+  }
+}
+
+int main() {
+
+  cout << "Cores: " << std::thread::hardware_concurrency() << endl << endl;
+
+  compare<position>("struct");
+  compare<std::string>("string");
+
+  /* exit */
+  return 0;
+
+}
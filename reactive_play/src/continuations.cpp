@@ -0,0 +1,53 @@
+/*
+ * Continuations forward changes from one domain to another
+ *
+ * We attach thousands of continuations to a signal and measure how long it takes
+ * until every one of them has reached the target domain
+ */
+
+#include <vector>
+
+#include <react/react.h>
+#include <react/Event.h>
+
+#include "utility.h"
+
+static size_t const CONTINUATION_COUNT = 5000;
+static unsigned long const TURN_COUNT = 100;
+
+/** cpp react stuff */
+REACTIVE_DOMAIN(Src, react::parallel)
+REACTIVE_DOMAIN(Dst, react::sequential_concurrent)
+
+int main() {
+
+  react::VarSignal<Src, int> source = react::MakeVar<Src>(0);
+  react::EventSource<Dst, int> target = react::MakeEventSource<Dst, int>();
+
+  auto received = 0;
+  react::Observe(target, [&received](int) { ++received; });
+
+  std::vector<react::Continuation<Src, Dst>> continuations;
+  continuations.reserve(CONTINUATION_COUNT);
+
+  for(size_t i = 0; i < CONTINUATION_COUNT; ++i) {
+    continuations.push_back(react::MakeContinuation<Src, Dst>(source,
+      [&target](int v) { target << v; }));
+  }
+
+  auto i = 0;
+  const auto react_duration = time_run(
+    [&source, &i]() {
+      // Returns once all continuations have been processed by Dst
+      source <<= ++i;
+    }, TURN_COUNT);
+
+  print_duration("CppReact continuation turn", react_duration);
+
+  cout << "Continuations per turn: " << CONTINUATION_COUNT
+       << ", received: " << received << endl;
+
+  /* exit */
+  return 0;
+
+}
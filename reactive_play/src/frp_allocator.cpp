@@ -0,0 +1,85 @@
+/*
+ * frp pipelines with custom allocators
+ *
+ * A frp source of 100k values feeds a map, a filter and a map_cache; every
+ * write changes one value. Allocations are counted by replacing operator new.
+ * With the default allocator every commit allocates its values; with
+ * frp::util::pool_allocator_type, passed through frp::allocate_with, each
+ * commit takes the blocks released by the commit it replaces, and with
+ * frp::util::arena_allocator_type the values come from large chunks that are
+ * rewound once the commits allocated from them are released
+ */
+
+#include <functional>
+#include <vector>
+
+#include <frp/allocate_with.h>
+#include <frp/static/push/filter.h>
+#include <frp/static/push/map.h>
+#include <frp/static/push/map_cache.h>
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/util/allocator.h>
+
+#include "allocation_counter.h"
+#include "utility.h"
+
+static size_t const VALUE_COUNT = 100000;
+static unsigned long const WARMUP_COUNT = 20;
+static unsigned long const WRITE_COUNT = 100;
+
+template<typename Allocator>
+static auto time_writes(const std::string &name, const Allocator &allocator) {
+  std::vector<int, Allocator> values(VALUE_COUNT, 0, allocator);
+  for (size_t i = 0; i < VALUE_COUNT; ++i) {
+    values[i] = int(i);
+  }
+
+  const auto source(frp::stat::push::source(values));
+  const auto map(frp::stat::push::map(frp::allocate_with(allocator, [](int value) {
+      return value * 2;
+    }), std::ref(source)));
+  const auto filter(frp::stat::push::filter(frp::allocate_with(allocator, [](int value) {
+      return value % 3 == 0;
+    }), std::ref(source)));
+  const auto map_cache(frp::stat::push::map_cache(frp::allocate_with(allocator, [](int value) {
+      return value + 1;
+    }), std::ref(source)));
+  const auto map_sink(frp::stat::push::sink(std::ref(map)));
+  const auto filter_sink(frp::stat::push::sink(std::ref(filter)));
+  const auto map_cache_sink(frp::stat::push::sink(std::ref(map_cache)));
+
+  auto write([&, i = 0]() mutable {
+    ++i;
+    values[i * 7919 % VALUE_COUNT] = i;
+    source = values;
+    consume(Foo(int((*map_sink)->size() + (*filter_sink)->size() + (*map_cache_sink)->size())));
+  });
+  for (unsigned long i = 0; i < WARMUP_COUNT; ++i) {
+    write();
+  }
+
+  const auto before = allocations.load();
+  const auto duration = time_run(write, WRITE_COUNT);
+  const auto write_allocations = allocations.load() - before;
+
+  print_duration("frp " + name + " single value write", duration);
+  cout << "frp " << name << " allocations per write: " << double(write_allocations) / WRITE_COUNT
+    << endl;
+  return duration;
+}
+
+int main() {
+
+  const auto default_duration = time_writes("std::allocator", std::allocator<int>());
+  const auto pool_duration = time_writes("pool_allocator",
+    frp::util::pool_allocator_type<int>());
+  time_writes("arena_allocator", frp::util::arena_allocator_type<int>(
+    std::make_shared<frp::util::arena_type>(4 << 20)));
+
+  print_duration_diff("pool_allocator", pool_duration, "std::allocator", default_duration);
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,97 @@
+/*
+ * frp batched writes
+ *
+ * A burst of writes to a frp source feeding a chain of transforms. Written one
+ * by one, every value is published and the whole chain is evaluated for each
+ * of them. A batch, or submit_many, publishes only the last value of the burst
+ * in one revision, so the chain is evaluated once. A stream source publishes
+ * the whole burst as one vector_view_type instead, for dependents that need
+ * every value
+ */
+
+#include <functional>
+#include <vector>
+
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/static/push/stream_source.h>
+#include <frp/static/push/transform.h>
+
+#include "utility.h"
+
+static unsigned long const BURST_SIZE = 1000;
+
+int main() {
+
+  const auto source(frp::stat::push::source(0));
+  const auto first(frp::stat::push::transform(
+    [](int value) { return value + 1; }, std::ref(source)));
+  const auto second(frp::stat::push::transform(
+    [](int value) { return value * 2; }, std::ref(first)));
+  const auto third(frp::stat::push::transform(
+    [](int value) { return value - 1; }, std::ref(second)));
+  const auto sink(frp::stat::push::sink(std::ref(third)));
+
+  int counter(0);
+
+  const auto write_duration = time_run(
+    [&source, &sink, &counter]() {
+      for (unsigned long i = 0; i < BURST_SIZE; ++i) {
+        source = ++counter;
+      }
+      consume(**sink);
+    }, REPEAT_COUNT);
+  print_duration("frp burst of single writes", write_duration);
+
+  const auto batch_duration = time_run(
+    [&source, &sink, &counter]() {
+      {
+        auto batch(source.batch());
+        for (unsigned long i = 0; i < BURST_SIZE; ++i) {
+          batch = ++counter;
+        }
+      }
+      consume(**sink);
+    }, REPEAT_COUNT);
+  print_duration("frp burst in a batch", batch_duration);
+
+  std::vector<int> burst(BURST_SIZE);
+  const auto submit_duration = time_run(
+    [&source, &sink, &counter, &burst]() {
+      for (auto &value : burst) {
+        value = ++counter;
+      }
+      source.submit_many(burst.begin(), burst.end());
+      consume(**sink);
+    }, REPEAT_COUNT);
+  print_duration("frp burst through submit_many", submit_duration);
+
+  const auto stream(frp::stat::push::stream_source<int>());
+  const auto sum(frp::stat::push::transform(
+    [](const frp::vector_view_type<int> &values) {
+      long sum(0);
+      for (auto value : values) {
+        sum += value;
+      }
+      return sum;
+    }, std::ref(stream)));
+  const auto stream_sink(frp::stat::push::sink(std::ref(sum)));
+
+  const auto stream_duration = time_run(
+    [&stream, &stream_sink, &counter]() {
+      {
+        auto batch(stream.batch());
+        for (unsigned long i = 0; i < BURST_SIZE; ++i) {
+          batch.push_back(++counter);
+        }
+      }
+      consume(**stream_sink);
+    }, REPEAT_COUNT);
+  print_duration("frp burst in a stream batch", stream_duration);
+
+  print_duration_diff("batch", batch_duration, "single writes", write_duration);
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Diamond-shaped frp graphs
+ *
+ * A source feeds a chain of diamonds: each level splits the previous result
+ * into two transforms and joins them again, a -> {b, c} -> d. Notifying each
+ * dependent as soon as one of its dependencies commits evaluates the joins
+ * once per path, which doubles with every level; evaluating repositories in
+ * depth order evaluates each of them once per write. We count evaluations of
+ * the transforms and time the writes
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/static/push/transform.h>
+
+#include "utility.h"
+
+static size_t const LEVEL_COUNTS[] = { 1, 4, 8 };
+static unsigned long const WRITE_COUNT = 1000;
+
+static size_t evaluations = 0;
+
+int main() {
+
+  for(auto level_count : LEVEL_COUNTS) {
+    const auto source(frp::stat::push::source(0));
+
+    std::vector<frp::stat::push::repository_type<int>> levels;
+    levels.reserve(level_count * 3 + 1);
+
+    auto previous = [&]() -> const auto& { return levels.back(); };
+    levels.push_back(frp::stat::push::transform([](int a) { ++evaluations; return a; },
+                                                std::ref(source)));
+    for(size_t i = 0; i < level_count; ++i) {
+      auto b = frp::stat::push::transform([](int a) { ++evaluations; return a + 1; }, std::ref(previous()));
+      auto c = frp::stat::push::transform([](int a) { ++evaluations; return a * 2; }, std::ref(previous()));
+      levels.push_back(std::move(b));
+      levels.push_back(std::move(c));
+      levels.push_back(frp::stat::push::transform([](int b, int c) { ++evaluations; return b + c; },
+                                                  std::ref(levels[levels.size() - 2]),
+                                                  std::ref(levels.back())));
+    }
+    evaluations = 0;
+    const auto duration = [&]() {
+      const auto sink(frp::stat::push::sink(std::ref(previous())));
+      return time_run(
+        [&source, &sink, i = 0]() mutable {
+          source = ++i % 1000;
+          consume(Foo(**sink));
+        }, WRITE_COUNT);
+    }();
+
+    const auto name = "frp " + std::to_string(level_count) + " diamonds";
+    print_duration(name + " write", duration);
+    cout << name << " evaluations per write: " << evaluations / WRITE_COUNT
+         << " (repositories: " << levels.size() << ")" << endl;
+
+    /* dependents go first */
+    while(!levels.empty())
+      levels.pop_back();
+  }
+
+  /* exit */
+  return 0;
+
+}
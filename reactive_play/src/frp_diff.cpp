@@ -0,0 +1,78 @@
+/*
+ * frp map and filter over single value updates
+ *
+ * A frp source of 1M values feeds a map and a filter; every write changes one
+ * value. With a std::vector source both are evaluated again for every value;
+ * with a frp::diff_vector_type source they only evaluate the changed value and
+ * share the rest of their previous result
+ */
+
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <frp/diff_vector.h>
+#include <frp/static/push/filter.h>
+#include <frp/static/push/map.h>
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+
+#include "utility.h"
+
+static size_t const VALUE_COUNT = 1000000;
+static unsigned long const VECTOR_WRITE_COUNT = 20;
+static unsigned long const DIFF_WRITE_COUNT = 10000;
+
+template<typename Vector, typename Write>
+static auto time_writes(const Vector &initial, unsigned long write_count, size_t &evaluations,
+    Write &&write) {
+  const auto source(frp::stat::push::source(initial));
+  const auto map(frp::stat::push::map([&evaluations](int value) {
+      ++evaluations;
+      return value * 2;
+    }, std::ref(source)));
+  const auto filter(frp::stat::push::filter([&evaluations](int value) {
+      ++evaluations;
+      return value % 3 == 0;
+    }, std::ref(source)));
+  const auto map_sink(frp::stat::push::sink(std::ref(map)));
+  const auto filter_sink(frp::stat::push::sink(std::ref(filter)));
+
+  evaluations = 0;
+  return time_run(
+    [&, i = 0]() mutable {
+      write(source, ++i);
+      consume(Foo((*map_sink)->size() + (*filter_sink)->size()));
+    }, write_count);
+}
+
+int main() {
+
+  std::vector<int> values(VALUE_COUNT);
+  std::iota(values.begin(), values.end(), 0);
+  auto diff_values = frp::diff_vector_type<int>(values.begin(), values.end());
+  size_t evaluations;
+
+  const auto vector_duration = time_writes(values, VECTOR_WRITE_COUNT, evaluations,
+    [&values](const auto &source, int i) {
+      values[i * 7919 % VALUE_COUNT] = i;
+      source = values;
+    });
+  print_duration("frp std::vector single value write", vector_duration);
+  cout << "frp std::vector evaluations per write: " << evaluations / VECTOR_WRITE_COUNT << endl;
+
+  const auto diff_duration = time_writes(diff_values, DIFF_WRITE_COUNT, evaluations,
+    [&diff_values](const auto &source, int i) {
+      diff_values = diff_values.set(i * 7919 % VALUE_COUNT, i);
+      source = diff_values;
+    });
+  print_duration("frp diff_vector single value write", diff_duration);
+  cout << "frp diff_vector evaluations per write: " << evaluations / DIFF_WRITE_COUNT << endl;
+
+  print_duration_diff("diff_vector", diff_duration, "std::vector", vector_duration);
+
+  /* exit */
+  return 0;
+
+}
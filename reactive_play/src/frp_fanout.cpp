@@ -0,0 +1,44 @@
+/*
+ * frp sources with many dependents
+ *
+ * A frp source is observed by 1, 10, 100 and 1000 sinks; we time writing it
+ * and reading one of the sinks back. Every write walks the source's callbacks,
+ * which are kept in a contiguous snapshot, so the walk costs no locking and
+ * no reference counting per callback
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+
+#include "utility.h"
+
+static size_t const SINK_COUNTS[] = { 1, 10, 100, 1000 };
+static unsigned long const WRITE_COUNT = 10000;
+
+int main() {
+
+  for(auto sink_count : SINK_COUNTS) {
+    const auto source(frp::stat::push::source<Foo>());
+
+    std::vector<frp::stat::push::sink_type<Foo>> sinks;
+    sinks.reserve(sink_count);
+    for(size_t i = 0; i < sink_count; ++i)
+      sinks.push_back(frp::stat::push::sink(std::ref(source)));
+
+    const auto duration = time_run(
+      [&source, &sinks, i = 0]() mutable {
+        source = Foo(++i);
+        consume(**sinks.back());
+      }, WRITE_COUNT);
+
+    print_duration("frp " + std::to_string(sink_count) + " sinks write", duration);
+  }
+
+  /* exit */
+  return 0;
+
+}
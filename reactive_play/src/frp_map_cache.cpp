@@ -0,0 +1,161 @@
+/*
+ * frp map_cache over single value updates
+ *
+ * A frp source of 1M values feeds a map and a map_cache; every write changes
+ * one value. map evaluates every value again, map_cache looks each value up in
+ * the cache of its previous result and only evaluates the changed one, then
+ * builds the cache of the new result. The previous map_cache, which kept its
+ * cache in a std::unordered_map, is copied below for comparison
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include <frp/static/push/map.h>
+#include <frp/static/push/map_cache.h>
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+
+#include "utility.h"
+
+static size_t const VALUE_COUNT = 1000000;
+static unsigned long const WRITE_COUNT = 20;
+
+static double expensive(int value) {
+  double result(value);
+  for (int i = 0; i < 16; ++i) {
+    result = std::sqrt(result + i);
+  }
+  return result;
+}
+
+/* map_cache with a std::unordered_map cache, for a single dependency */
+namespace unordered_map_cache {
+
+namespace details = frp::stat::push::details;
+namespace internal = frp::internal;
+namespace util = frp::util;
+
+template<typename K, typename V, typename Container>
+struct commit_storage_type : util::commit_storage_type<Container, 1> {
+
+  typedef std::unordered_map<K, std::reference_wrapper<const V>> cache_type;
+  typedef typename util::commit_storage_type<Container, 1>::revisions_type revisions_type;
+  cache_type cache;
+
+  commit_storage_type(Container &&value, util::revision_type revision,
+    const revisions_type &revisions) : util::commit_storage_type<Container, 1>(
+      std::forward<Container>(value), revision, revisions) {}
+};
+
+template<typename Function, typename Dependency>
+auto map_cache(Function &&function, Dependency dependency) {
+  typedef typename util::unwrap_reference_t<Dependency>::value_type argument_container_type;
+  typedef typename argument_container_type::value_type argument_type;
+  typedef util::map_return_t<0, Function, Dependency> value_type;
+  typedef std::equal_to<value_type> comparator_type;
+  typedef frp::vector_view_type<value_type, comparator_type> collector_view_type;
+  typedef commit_storage_type<argument_type, value_type, collector_view_type> storage_type;
+  typedef util::fixed_size_collector_type<value_type, comparator_type> collector_type;
+  typedef std::array<util::revision_type, 1> revisions_type;
+  return details::make_repository<collector_view_type, storage_type,
+      std::equal_to<collector_view_type>>([
+        function = internal::get_function(util::unwrap_reference(std::forward<Function>(function))),
+        executor = internal::get_executor(util::unwrap_reference(std::forward<Function>(function)))](
+        auto &&callback, const auto &previous_storage, const auto &dependencies) {
+    auto previous(previous_storage->load());
+    auto values(util::invoke([&](const auto&... dependency) {
+      return std::make_tuple(internal::get_storage(util::unwrap_container(dependency))...);
+    }, *dependencies));
+
+    revisions_type revisions{ std::get<0>(values)->revision };
+    auto &collection(std::get<0>(values)->value);
+    if (collection.empty()) {
+      callback(util::make_storage<storage_type>(
+        collector_view_type(collector_type(0)), util::default_revision, revisions));
+    } else {
+      auto collector(std::make_shared<collector_type>(collection.size()));
+      bool cache_usable(previous);
+      internal::for_range(executor, collection.size(), [function, collector, &collection,
+          callback, previous, revisions, cache_usable, values](
+          std::size_t begin, std::size_t end) {
+        auto it(std::next(std::begin(collection), begin));
+        for (auto index = begin; index < end; ++index, ++it) {
+          typename storage_type::cache_type::iterator cached;
+          if (cache_usable && (cached = previous->cache.find(*it))
+            != previous->cache.end()) {
+            collector->emplace(index, cached->second);
+          } else {
+            collector->emplace(index, function(*it));
+          }
+        }
+        if (collector->complete(end - begin)) {
+          auto commit(util::make_storage<storage_type>(
+            collector_view_type(std::move(*collector)), util::default_revision, revisions));
+          std::transform(std::begin(collection), std::end(collection),
+            std::begin(commit->value),
+            std::inserter(commit->cache, std::end(commit->cache)),
+            [](auto &key, auto &value) {
+              return std::make_pair(key, std::ref(value));
+            });
+          callback(commit);
+        }
+      });
+    }
+  }, std::forward<Dependency>(dependency));
+}
+
+} // namespace unordered_map_cache
+
+template<typename Transform>
+static auto time_writes(std::vector<int> values, Transform &&transform) {
+  const auto source(frp::stat::push::source(values));
+  const auto mapped(transform(std::ref(source)));
+  const auto sink(frp::stat::push::sink(std::ref(mapped)));
+
+  values[0] = -1;
+  source = values;
+  return time_run(
+    [&, i = 0]() mutable {
+      ++i;
+      values[i * 7919 % VALUE_COUNT] = i;
+      source = values;
+      consume(Foo((*sink)->size()));
+    }, WRITE_COUNT);
+}
+
+int main() {
+
+  std::vector<int> values(VALUE_COUNT);
+  std::iota(values.begin(), values.end(), 0);
+
+  const auto map_duration = time_writes(values, [](const auto &source) {
+      return frp::stat::push::map(expensive, source);
+    });
+  print_duration("frp map single value write", map_duration);
+
+  const auto cache_duration = time_writes(values, [](const auto &source) {
+      return frp::stat::push::map_cache(expensive, source);
+    });
+  print_duration("frp map_cache single value write", cache_duration);
+
+  const auto unordered_duration = time_writes(values, [](const auto &source) {
+      return unordered_map_cache::map_cache(expensive, source);
+    });
+  print_duration("frp unordered_map map_cache single value write", unordered_duration);
+
+  cout << endl;
+
+  print_duration_diff("map_cache", cache_duration, "map", map_duration);
+  print_duration_diff("map_cache", cache_duration, "unordered_map map_cache",
+    unordered_duration);
+
+  /* exit */
+  return 0;
+
+}
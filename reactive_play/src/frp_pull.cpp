@@ -0,0 +1,78 @@
+/*
+ * frp push against pull at different write:read ratios
+ *
+ * A frp source feeds a chain of three transforms and a sink. Push
+ * repositories evaluate the chain on every write; pull repositories only mark
+ * it dirty and evaluate it when the sink is dereferenced. Every run writes
+ * 1000 values and reads the sink after every 1, 10, 100 or 1000 writes
+ */
+
+#include <cmath>
+#include <functional>
+#include <string>
+
+#include <frp/static/pull/sink.h>
+#include <frp/static/pull/source.h>
+#include <frp/static/pull/transform.h>
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/static/push/transform.h>
+
+#include "utility.h"
+
+static unsigned long const WRITE_COUNT = 1000;
+static unsigned long const RUN_COUNT = 10;
+
+static double expensive(double value) {
+  for (int i = 0; i < 256; ++i) {
+    value = std::sqrt(value + i);
+  }
+  return value;
+}
+
+template<typename Source, typename Transform, typename Sink>
+static auto time_writes(Source &&make_source, Transform &&transform, Sink &&sink,
+    unsigned long writes_per_read) {
+  const auto source(make_source());
+  const auto first(transform(expensive, std::ref(source)));
+  const auto second(transform(expensive, std::ref(first)));
+  const auto third(transform(expensive, std::ref(second)));
+  const auto result(sink(std::ref(third)));
+
+  return time_run(
+    [&, i = 0]() mutable {
+      for (unsigned long write = 1; write <= WRITE_COUNT; ++write) {
+        source = ++i;
+        if (write % writes_per_read == 0) {
+          consume(Foo(int(**result)));
+        }
+      }
+    }, RUN_COUNT);
+}
+
+int main() {
+
+  for (unsigned long writes_per_read : { 1, 10, 100, 1000 }) {
+    const auto ratio = std::to_string(writes_per_read) + ":1";
+
+    const auto push_duration = time_writes(
+      []() { return frp::stat::push::source(0.); },
+      [](auto &&... arguments) { return frp::stat::push::transform(arguments...); },
+      [](auto &&dependency) { return frp::stat::push::sink(dependency); },
+      writes_per_read);
+    print_duration("frp push " + ratio, push_duration);
+
+    const auto pull_duration = time_writes(
+      []() { return frp::stat::pull::source(0.); },
+      [](auto &&... arguments) { return frp::stat::pull::transform(arguments...); },
+      [](auto &&dependency) { return frp::stat::pull::sink(dependency); },
+      writes_per_read);
+    print_duration("frp pull " + ratio, pull_duration);
+
+    print_duration_diff("pull", pull_duration, "push", push_duration);
+  }
+
+  /* exit */
+  return 0;
+
+}
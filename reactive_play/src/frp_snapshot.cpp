@@ -0,0 +1,54 @@
+/*
+ * frp sink reads
+ *
+ * Dereferencing a frp sink adds and removes a reference to the value it
+ * returns. A snapshot of the sink keeps the last value it read and only takes a
+ * new reference when the sink value changed, so reading an unchanged value
+ * does not touch any reference count
+ */
+
+#include <functional>
+
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+
+#include "utility.h"
+
+static unsigned long const READ_COUNT = 1000000;
+
+int main() {
+
+  const auto source(frp::stat::push::source(Foo(0)));
+  const auto sink(frp::stat::push::sink(std::ref(source)));
+
+  const auto reference_duration = time_run(
+    [&sink]() {
+      consume(**sink);
+    }, READ_COUNT);
+  print_duration("frp sink dereference", reference_duration);
+
+  const auto get_duration = time_run(
+    [&sink]() {
+      const auto value((*sink).get());
+      if (value) {
+        consume(*value);
+      }
+    }, READ_COUNT);
+  print_duration("frp sink reference get", get_duration);
+
+  auto snapshot(sink.snapshot());
+  const auto snapshot_duration = time_run(
+    [&snapshot]() {
+      const auto value(snapshot.get());
+      if (value) {
+        consume(*value);
+      }
+    }, READ_COUNT);
+  print_duration("frp sink snapshot get", snapshot_duration);
+
+  print_duration_diff("snapshot", snapshot_duration, "dereference", reference_duration);
+
+  /* exit */
+  return 0;
+
+}
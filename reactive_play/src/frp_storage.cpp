@@ -0,0 +1,61 @@
+/*
+ * Allocations and latency of frp writes
+ *
+ * A frp source is written and its sink read back, once directly and once
+ * through a transform. We count the heap allocations made per write and time
+ * the same loop as the Simple Source/Sink play. Storage for each written value
+ * and for each commit comes from a per-type pool, so once the pools are warm
+ * writes only allocate for the observer callbacks
+ */
+
+#include <functional>
+#include <string>
+
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/static/push/transform.h>
+
+#include "allocation_counter.h"
+#include "utility.h"
+
+template <typename Source, typename Sink>
+void measure(const std::string& name, Source& source, Sink& sink) {
+  /* warm up */
+  for(size_t i = 0; i < LOOP_COUNT; ++i)
+    source = Foo(static_cast<int>(i));
+
+  const auto first_allocation = allocations.load();
+
+  const auto duration = time_run(
+    [&source, &sink]() {
+      for(size_t i = 0; i < LOOP_COUNT; ++i) {
+        source = Foo(static_cast<int>(i));
+        consume(**sink);
+      }
+    });
+
+  const auto writes = LOOP_COUNT * REPEAT_COUNT;
+
+  print_duration("frp " + name, duration);
+  cout << "frp " + name + " allocations per write: "
+       << static_cast<double>(allocations - first_allocation) / writes << endl;
+}
+
+int main() {
+
+  const auto source(frp::stat::push::source<Foo>());
+  const auto sink(frp::stat::push::sink(std::ref(source)));
+  measure("source/sink", source, sink);
+
+  cout << endl;
+
+  const auto transformed_source(frp::stat::push::source<Foo>());
+  const auto transform(frp::stat::push::transform([](const Foo& foo) { return Foo(foo.getData() + 1); },
+                                                  std::ref(transformed_source)));
+  const auto transformed_sink(frp::stat::push::sink(std::ref(transform)));
+  measure("source/transform/sink", transformed_source, transformed_sink);
+
+  /* exit */
+  return 0;
+
+}
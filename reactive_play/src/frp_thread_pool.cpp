@@ -0,0 +1,86 @@
+/*
+ * frp map on a thread pool
+ *
+ * A frp map over 1M values, run immediately, on a thread pool with one task per
+ * value, and on the same pool with one task per range of values. We time
+ * writing the source until the mapped vector is committed
+ */
+
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <frp/static/push/map.h>
+#include <frp/static/push/sink.h>
+#include <frp/static/push/source.h>
+#include <frp/static/push/transform.h>
+#include <frp/thread_pool.h>
+
+#include "utility.h"
+
+static size_t const VALUE_COUNT = 1000000;
+static unsigned long const WRITE_COUNT = 10;
+
+/* hides for_range, so map submits one task per value */
+struct per_value_executor {
+  frp::thread_pool_type &pool;
+
+  template<typename F>
+  void operator()(F &&f) const {
+    pool(std::forward<F>(f));
+  }
+};
+
+template<typename Function>
+static auto time_map(Function &&function) {
+  std::vector<double> values(VALUE_COUNT);
+  std::iota(values.begin(), values.end(), 0.0);
+  const auto source(frp::stat::push::source(values));
+  const auto map(frp::stat::push::map(std::forward<Function>(function), std::ref(source)));
+  std::atomic_size_t commits(0);
+  const auto done(frp::stat::push::transform([&commits](const auto &mapped) {
+      ++commits;
+      return mapped.size();
+    }, std::ref(map)));
+  const auto sink(frp::stat::push::sink(std::ref(done)));
+  while(commits.load() == 0)
+    std::this_thread::yield();
+
+  const auto write([&]() {
+      const auto expected(commits.load() + 1);
+      values.front() += 1;
+      source = values;
+      while(commits.load() < expected)
+        std::this_thread::yield();
+      consume(Foo(static_cast<int>(**sink)));
+    });
+
+  /* the first write faults in the memory the later ones reuse */
+  write();
+  return time_run(write, WRITE_COUNT);
+}
+
+int main() {
+
+  const auto square([](double value) { return value * value; });
+
+  const auto immediate = time_map(square);
+  print_duration("frp map immediate", immediate);
+
+  frp::thread_pool_type pool;
+
+  const auto per_value = time_map(frp::execute_on(per_value_executor{ pool }, square));
+  print_duration("frp map pool, task per value", per_value);
+
+  const auto ranges = time_map(frp::execute_on(std::ref(pool), square));
+  print_duration("frp map pool, task per range", ranges);
+
+  print_duration_diff("task per range", ranges, "task per value", per_value);
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Large graphs are built once at startup and then brought to their last known state
+ *
+ * We build a graph of 50k signals node by node and in bulk, then compare replaying the
+ * saved inputs one by one with restoring them from a checkpoint in a single turn. The
+ * checkpoint is also written to a stream and loaded into the graph built in bulk, as a
+ * restarted process would
+ */
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <react/react.h>
+
+#include "utility.h"
+
+static size_t const INPUT_COUNT = 500;
+static size_t const NODE_COUNT = 50'000;
+
+/** cpp react stuff */
+REACTIVE_DOMAIN(Replayed, react::sequential)
+REACTIVE_DOMAIN(Restored, react::sequential)
+REACTIVE_DOMAIN(Restarted, react::sequential)
+
+int add(int a, int b) { return a + b; }
+
+template <typename D>
+struct Graph {
+  std::vector<react::VarSignal<D, int>> inputs;
+  std::vector<react::Signal<D, int>> nodes;
+};
+
+/* Every derived node combines two random nodes that were created before it */
+template <typename D>
+void build(Graph<D>& graph) {
+  std::mt19937 rng(42);
+
+  for(size_t i = 0; i < INPUT_COUNT; ++i) {
+    graph.inputs.push_back(react::MakeVar<D>(0));
+    graph.nodes.push_back(graph.inputs.back());
+  }
+
+  while(graph.nodes.size() < NODE_COUNT) {
+    std::uniform_int_distribution<size_t> pick(0, graph.nodes.size() - 1);
+
+    const auto& a = graph.nodes[pick(rng)];
+    const auto& b = graph.nodes[pick(rng)];
+
+    graph.nodes.push_back(react::MakeSignal<D>(With(a, b), add));
+  }
+}
+
+int main() {
+
+  /* Build */
+  Graph<Replayed> replayed;
+
+  const auto build_duration = time_run(
+    [&replayed]() {
+      build(replayed);
+    }, 1);
+
+  print_duration("CppReact build", build_duration);
+
+  Graph<Restarted> restarted;
+
+  const auto bulk_build_duration = time_run(
+    [&restarted]() {
+      react::DoBulkConstruction<Restarted>([&restarted] {
+        build(restarted);
+      });
+    }, 1);
+
+  print_duration("CppReact bulk build", bulk_build_duration);
+
+  Graph<Restored> restored;
+  build(restored);
+
+  /* Save a state, then go back to the initial one */
+  react::SignalCheckpoint<Restored> checkpoint;
+
+  for(size_t i = 0; i < INPUT_COUNT; ++i) {
+    restored.inputs[i] <<= static_cast<int>(i);
+    checkpoint.Track(restored.inputs[i]);
+  }
+
+  const auto saved = restored.nodes.back().Value();
+
+  for(auto& input : restored.inputs)
+    input <<= 0;
+
+  /* Bring the graph back to the saved state */
+  const auto replay_duration = time_run(
+    [&replayed]() {
+      for(size_t i = 0; i < INPUT_COUNT; ++i)
+        replayed.inputs[i] <<= static_cast<int>(i);
+    }, 1);
+
+  print_duration("CppReact replay inputs", replay_duration);
+
+  const auto restore_duration = time_run(
+    [&checkpoint]() {
+      checkpoint.Restore();
+    }, 1);
+
+  print_duration("CppReact restore checkpoint", restore_duration);
+
+  /* Restart from the checkpoint written to a stream */
+  std::stringstream stream;
+  checkpoint.Save(stream);
+
+  react::SignalCheckpoint<Restarted> loaded;
+  for(auto& input : restarted.inputs)
+    loaded.Track(input);
+
+  const auto load_duration = time_run(
+    [&loaded, &stream]() {
+      loaded.Load(stream);
+      loaded.Restore();
+    }, 1);
+
+  print_duration("CppReact load and restore checkpoint", load_duration);
+
+  /* stats */
+  cout << endl;
+
+  print_duration_diff("CppReact bulk build", bulk_build_duration,
+                      "CppReact build", build_duration);
+  print_duration_diff("CppReact restore checkpoint", restore_duration,
+                      "CppReact replay inputs", replay_duration);
+
+  cout << "Saved state reached: "
+       << (restored.nodes.back().Value() == saved &&
+           replayed.nodes.back().Value() == saved &&
+           restarted.nodes.back().Value() == saved ? "yes" : "no") << endl;
+
+  /* exit */
+  return 0;
+
+}
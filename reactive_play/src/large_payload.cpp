@@ -0,0 +1,76 @@
+/*
+ * Allocations per update for 1 MB payloads
+ *
+ * A source value holding a 1 MB buffer feeds an expression that mirrors it and
+ * an expression that computes its checksum; an observer also reads the
+ * mirror. We count the heap allocations, and the bytes they request, made by
+ * each update, first with the buffer stored by value, then stored as a shared
+ * snapshot
+ */
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "allocation_counter.h"
+#include "utility.h"
+
+static size_t const PAYLOAD_SIZE = 1 << 20;
+static unsigned long const UPDATE_COUNT = 100;
+
+using payload = std::vector<char>;
+
+struct checksum {
+  auto operator()(const payload& p) const { return std::accumulate(p.begin(), p.end(), size_t { 0 }); }
+  auto operator()(const observable::snapshot<payload>& p) const { return (*this)(*p); }
+};
+
+OBSERVABLE_ADAPT_FILTER(checksum_, checksum { })
+
+template <typename Value, typename Make>
+void measure(const std::string& name, Make make) {
+  observable::value<Value> source { make(0) };
+  auto mirror = observable::observe(source);
+  auto sum = observable::observe(checksum_(source));
+  auto sub = mirror.subscribe([](const Value& v) { consume(Foo(static_cast<int>(sizeof(v)))); });
+
+  size_t update_allocations = 0;
+  size_t update_bytes = 0;
+
+  const auto duration = time_run(
+    [&, i = 0]() mutable {
+      auto next = make(++i);
+
+      const auto first_allocation = allocations.load();
+      const auto first_byte = allocated_bytes.load();
+
+      source = std::move(next);
+
+      update_allocations += allocations - first_allocation;
+      update_bytes += allocated_bytes - first_byte;
+    }, UPDATE_COUNT);
+
+  consume(Foo(static_cast<int>(sum.get())));
+
+  print_duration("Observable " + name + " update", duration);
+  cout << "Observable " + name + " allocations per update: "
+       << static_cast<double>(update_allocations) / UPDATE_COUNT << " ("
+       << update_bytes / UPDATE_COUNT / 1024 << " KB)" << endl;
+}
+
+int main() {
+
+  measure<payload>("value", [](int i) { return payload(PAYLOAD_SIZE, static_cast<char>(i)); });
+
+  cout << endl;
+
+  measure<observable::snapshot<payload>>("snapshot", [](int i) {
+    return observable::make_snapshot<payload>(PAYLOAD_SIZE, static_cast<char>(i));
+  });
+
+  /* exit */
+  return 0;
+
+}
@@ -0,0 +1,59 @@
+/*
+ * A subject with many observers is notified much more often than its observers change
+ *
+ * We notify 1, 100 and 10k observers and compare the default observable subject,
+ * which keeps its observers in a linked list, with a snapshot subject, which keeps
+ * them in a contiguous array
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static unsigned long const CALLS_PER_RUN = 1'000'000;
+
+template <typename Subject>
+auto run_fanout(size_t observer_count) {
+  Subject subject;
+
+  /* observers are subscribed over time, so other allocations end up between them */
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> size(16, 1024);
+  std::vector<std::vector<char>> unrelated;
+
+  for(size_t i = 0; i < observer_count; ++i) {
+    subject.subscribe(consume);
+    unrelated.emplace_back(size(rng));
+  }
+
+  /* keep the total number of observer calls the same for every count */
+  return time_run(
+    [&subject]() {
+      subject.notify(Foo(1));
+    }, CALLS_PER_RUN / observer_count);
+}
+
+int main() {
+
+  for(const size_t count : { 1, 100, 10'000 }) {
+    const auto list_duration = run_fanout<observable::subject<void(Foo)>>(count);
+    const auto snapshot_duration = run_fanout<observable::snapshot_subject<void(Foo)>>(count);
+
+    const auto suffix = " notify " + std::to_string(count);
+
+    print_duration("Observable list" + suffix, list_duration);
+    print_duration("Observable snapshot" + suffix, snapshot_duration);
+    print_duration_diff("Observable snapshot" + suffix, snapshot_duration,
+                        "Observable list" + suffix, list_duration);
+
+    cout << endl;
+  }
+
+  /* exit */
+  return 0;
+
+}
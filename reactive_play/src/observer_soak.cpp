@@ -0,0 +1,84 @@
+/*
+ * Subjects that are notified from many threads while observers come and go
+ *
+ * 16 threads keep notifying an observable subject while 2 other threads keep
+ * subscribing and unsubscribing observers. Every observer that is still stored
+ * by the subject, including removed ones that were not reclaimed yet, is counted
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static size_t const NOTIFY_THREADS = 16;
+static size_t const CHURN_THREADS = 2;
+static size_t const STABLE_OBSERVERS = 100;
+static size_t const SAMPLE_COUNT = 10;
+static auto const SAMPLE_INTERVAL = std::chrono::milliseconds(300);
+
+/* Counts the observer copies alive */
+struct Tracked {
+  static std::atomic<long> alive;
+
+  Tracked() { ++alive; }
+  Tracked(const Tracked&) { ++alive; }
+  ~Tracked() { --alive; }
+};
+
+std::atomic<long> Tracked::alive { 0 };
+
+int main() {
+
+  observable::subject<void(Foo)> subject;
+
+  auto observer = [tracked = Tracked()](Foo f) { consume(f); };
+
+  for(size_t i = 0; i < STABLE_OBSERVERS; ++i)
+    subject.subscribe(observer);
+
+  std::atomic<bool> stop { false };
+  std::atomic<long> notifies { 0 };
+  std::atomic<long> churns { 0 };
+  std::vector<std::thread> threads;
+
+  for(size_t i = 0; i < NOTIFY_THREADS; ++i) {
+    threads.emplace_back([&]() {
+      while(!stop) {
+        subject.notify(Foo(1));
+        ++notifies;
+      }
+    });
+  }
+
+  for(size_t i = 0; i < CHURN_THREADS; ++i) {
+    threads.emplace_back([&]() {
+      while(!stop) {
+        subject.subscribe(observer).unsubscribe();
+        ++churns;
+      }
+    });
+  }
+
+  for(size_t i = 1; i <= SAMPLE_COUNT; ++i) {
+    std::this_thread::sleep_for(SAMPLE_INTERVAL);
+
+    cout << "Observable soak " << (i * SAMPLE_INTERVAL).count() << " ms"
+         << " stored observers: " << Tracked::alive - 1
+         << " notifies: " << notifies
+         << " subscribe/unsubscribe: " << churns << endl;
+  }
+
+  stop = true;
+
+  for(auto& t : threads)
+    t.join();
+
+  /* exit */
+  return 0;
+
+}
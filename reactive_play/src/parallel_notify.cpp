@@ -0,0 +1,70 @@
+/*
+ * A subject with many expensive observers
+ *
+ * We notify 64 observers one after another on the calling thread, and in
+ * parallel on a thread pool. The observers either keep the CPU busy or block,
+ * like an observer that waits for I/O would
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static size_t const OBSERVER_COUNT = 64;
+static unsigned long const NOTIFY_COUNT = 20;
+static auto const OBSERVER_WORK = std::chrono::microseconds(100);
+
+void busy_observer(Foo f) {
+  const auto end = std::chrono::steady_clock::now() + OBSERVER_WORK;
+  while(std::chrono::steady_clock::now() < end)
+    consume(f);
+}
+
+void blocking_observer(Foo f) {
+  std::this_thread::sleep_for(OBSERVER_WORK);
+  consume(f);
+}
+
+void compare(const std::string& name, void (*observer)(Foo), observable::thread_pool& pool) {
+  observable::snapshot_subject<void(Foo)> subject;
+
+  for(size_t i = 0; i < OBSERVER_COUNT; ++i)
+    subject.subscribe(observer);
+
+  const auto serial_duration = time_run(
+    [&subject]() {
+      subject.notify(Foo(1));
+    }, NOTIFY_COUNT);
+
+  print_duration("Observable " + name + " notify", serial_duration);
+
+  const auto parallel_duration = time_run(
+    [&subject, &pool]() {
+      subject.notify_parallel(pool, Foo(1)).get();
+    }, NOTIFY_COUNT);
+
+  print_duration("Observable " + name + " notify_parallel", parallel_duration);
+
+  print_duration_diff("Observable " + name + " notify_parallel", parallel_duration,
+                      "Observable " + name + " notify", serial_duration);
+}
+
+int main() {
+
+  observable::thread_pool pool(std::max(std::thread::hardware_concurrency(), 8u));
+
+  cout << "Cores: " << std::thread::hardware_concurrency()
+       << ", pool threads: " << pool.concurrency() << endl << endl;
+
+  compare("busy", busy_observer, pool);
+  cout << endl;
+  compare("blocking", blocking_observer, pool);
+
+  /* exit */
+  return 0;
+
+}
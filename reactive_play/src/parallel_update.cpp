@@ -0,0 +1,84 @@
+/*
+ * Thousands of derived values updated once per frame
+ *
+ * 1000 input values feed 2000 first-level and 1000 second-level expressions,
+ * each doing some arithmetic. Every frame changes a tenth of the inputs and
+ * then updates all expressions, once with an observable::updater and once
+ * with an observable::parallel_updater, which skips the expressions whose
+ * inputs did not change and evaluates each level on a thread pool
+ */
+
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <observable/observable.hpp>
+
+#include "utility.h"
+
+static size_t const INPUT_COUNT = 1000;
+static size_t const FRAME_COUNT = 60;
+static size_t const CHANGED_PER_FRAME = INPUT_COUNT / 10;
+
+struct work {
+  double operator()(double x) const {
+    for(int i = 0; i < 200; ++i)
+      x = std::sqrt(x * x + 1.0);
+    return x;
+  }
+};
+
+OBSERVABLE_ADAPT_FILTER(work_, work { })
+
+template <typename Updater, typename UpdateAll>
+auto run(Updater& updater, std::vector<observable::value<double>>& inputs, UpdateAll update_all) {
+  std::vector<observable::value<double>> derived;
+  derived.reserve(INPUT_COUNT * 3);
+
+  for(size_t i = 0; i < INPUT_COUNT * 2; ++i)
+    derived.push_back(observe(updater, work_(inputs[i % INPUT_COUNT] + 1.0)));
+
+  for(size_t i = 0; i < INPUT_COUNT; ++i)
+    derived.push_back(observe(updater, work_(derived[i] * derived[i + INPUT_COUNT])));
+
+  size_t frame = 0;
+  return time_run(
+    [&]() {
+      ++frame;
+      for(size_t i = 0; i < CHANGED_PER_FRAME; ++i)
+        inputs[(frame * CHANGED_PER_FRAME + i) % INPUT_COUNT] = static_cast<double>(frame);
+
+      update_all();
+    }, FRAME_COUNT);
+}
+
+int main() {
+
+  std::vector<observable::value<double>> inputs(INPUT_COUNT);
+
+  observable::updater plain;
+  const auto serial_duration = run(plain, inputs, [&]() { plain.update_all(); });
+  print_duration("Observable updater", serial_duration);
+
+  observable::parallel_updater parallel;
+  observable::parallel_updater::stats totals;
+  const auto parallel_duration = run(parallel, inputs, [&]() {
+    const auto stats = parallel.update_all();
+    totals.evaluated += stats.evaluated;
+    totals.skipped += stats.skipped;
+  });
+  print_duration("Observable parallel_updater", parallel_duration);
+
+  print_duration_diff("Observable parallel_updater", parallel_duration,
+                      "Observable updater", serial_duration);
+
+  cout << endl << "Cores: " << std::thread::hardware_concurrency() << endl
+       << "Expressions per frame: " << INPUT_COUNT * 3
+       << ", evaluated: " << totals.evaluated / FRAME_COUNT
+       << ", skipped: " << totals.skipped / FRAME_COUNT << endl;
+
+  /* exit */
+  return 0;
+
+}
@@ -5,6 +5,10 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include "react/engine/ToposortEngine.h"
+
+#include <algorithm>
+#include <iterator>
+
 #include "tbb/parallel_for.h"
 
 /***************************************/ REACT_IMPL_BEGIN /**************************************/
@@ -30,6 +34,12 @@ ParTurn::ParTurn(TurnIdT id, TransactionFlagsT flags) :
 template <typename TNode, typename TTurn>
 void EngineBase<TNode,TTurn>::OnNodeAttach(TNode& node, TNode& parent)
 {
+    if (isBulkAttach_)
+    {
+        bulkEdges_.emplace_back(&node, &parent);
+        return;
+    }
+
     parent.Successors.Add(node);
 
     if (node.Level <= parent.Level)
@@ -39,9 +49,72 @@ void EngineBase<TNode,TTurn>::OnNodeAttach(TNode& node, TNode& parent)
 template <typename TNode, typename TTurn>
 void EngineBase<TNode,TTurn>::OnNodeDetach(TNode& node, TNode& parent)
 {
+    if (isBulkAttach_)
+    {
+        // Usually a temporary node, so its edge was recorded recently
+        auto it = std::find(bulkEdges_.rbegin(), bulkEdges_.rend(), EdgeT( &node, &parent ));
+        if (it != bulkEdges_.rend())
+        {
+            bulkEdges_.erase(std::next(it).base());
+            return;
+        }
+    }
+
     parent.Successors.Remove(node);
 }
 
+template <typename TNode, typename TTurn>
+void EngineBase<TNode,TTurn>::OnBulkAttachBegin()
+{
+    isBulkAttach_ = true;
+}
+
+template <typename TNode, typename TTurn>
+void EngineBase<TNode,TTurn>::OnBulkAttachEnd()
+{
+    isBulkAttach_ = false;
+
+    if (bulkEdges_.empty())
+        return;
+
+    // Levels and the size of each successor range
+    size_t blockSize = 0;
+
+    for (const auto& e : bulkEdges_)
+    {
+        auto& node = *e.first;
+        auto& parent = *e.second;
+
+        if (node.Level <= parent.Level)
+            node.Level = parent.Level + 1;
+
+        // The successors a parent already has move to the block as well
+        if (parent.Successors.Reserve())
+            blockSize += parent.Successors.Size();
+
+        ++blockSize;
+    }
+
+    std::unique_ptr<TNode*[]> block( new TNode*[blockSize] );
+    auto* cur = block.get();
+
+    for (const auto& e : bulkEdges_)
+    {
+        auto& successors = e.second->Successors;
+
+        // First successor of this parent
+        if (successors.IsReserved())
+            cur = successors.MoveToBlock(cur);
+
+        successors.AddToBlock(*e.first);
+    }
+
+    successorBlocks_.push_back(std::move(block));
+
+    bulkEdges_.clear();
+    bulkEdges_.shrink_to_fit();
+}
+
 template <typename TNode, typename TTurn>
 void EngineBase<TNode,TTurn>::OnInputChange(TNode& node, TTurn& turn)
 {
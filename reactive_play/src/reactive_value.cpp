@@ -13,7 +13,9 @@
 #include "data_types.h"
 #include "utility.h"
 
-Foo merge(Foo a, Foo b) { return Foo(a.getData() + b.getData()); }
+static size_t merge_count = 0;
+
+Foo merge(Foo a, Foo b) { ++merge_count; return Foo(a.getData() + b.getData()); }
 
 /** observable stuff */
 OBSERVABLE_ADAPT_FILTER(merger, merge)
@@ -42,6 +44,8 @@ int main() {
   const auto c = observe( merger(a, b) );
   c.subscribe(consume);
 
+  merge_count = 0;
+
   const auto observable_duration = time_run(
     [&a, &b]() {
       for(auto i = 0; i < LOOP_COUNT; ++i) {
@@ -50,8 +54,26 @@ int main() {
       }
     });
 
+  const auto observable_merges = merge_count;
+
   print_duration("Observable", observable_duration);
 
+  /* Observable Example, both values changed in one batch */
+  merge_count = 0;
+
+  const auto observable_batch_duration = time_run(
+    [&a, &b]() {
+      for(auto i = 0; i < LOOP_COUNT; ++i) {
+        observable::batch batch;
+        a = Foo(i % 3);
+        b = Foo(i % 5);
+      }
+    });
+
+  const auto observable_batch_merges = merge_count;
+
+  print_duration("Observable batch", observable_batch_duration);
+
   /** CppReact example **/
   react::VarSignal<D, Foo> a_signal = react::MakeVar<D>(Foo(0));
   react::VarSignal<D, Foo> b_signal = react::MakeVar<D>(Foo(0));
@@ -92,6 +114,7 @@ int main() {
   cout << endl;
 
   print_duration_diff("Simple function", simple_duration, "Observable", observable_duration);
+  print_duration_diff("Simple function", simple_duration, "Observable batch", observable_batch_duration);
   print_duration_diff("Simple function", simple_duration, "CppReact", react_duration);
   print_duration_diff("Simple function", simple_duration, "reactive", reactive_duration);
 
@@ -100,6 +123,11 @@ int main() {
   print_duration_diff("Observable", observable_duration, "CppReact", react_duration);
   print_duration_diff("Observable", observable_duration, "reactive", reactive_duration);
 
+  cout << endl;
+
+  cout << "Observable merges: " << observable_merges << endl;
+  cout << "Observable batch merges: " << observable_batch_merges << endl;
+
   /* exit */
   return 0;
 
@@ -0,0 +1,125 @@
+/*
+ * Engines that track which inputs a node depends on keep one source id set per node
+ *
+ * We build the sets for a layered graph with hundreds of input nodes, then check
+ * which nodes are affected by a turn that changes a few of the inputs. The sets are
+ * keyed once on the ObjectId of the input nodes, which is their address, and once on
+ * their dense source index
+ */
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <react/react.h>
+#include <react/common/SourceIdSet.h>
+
+#include "utility.h"
+
+static size_t const INPUT_COUNT = 400;
+static size_t const LAYER_COUNT = 10;
+static size_t const LAYER_WIDTH = 200;
+static size_t const PREDECESSOR_COUNT = 3;
+static size_t const CHANGED_INPUT_COUNT = 5;
+static unsigned long const RUN_COUNT = 100;
+
+using IdSetT = react::impl::SourceIdSet<size_t>;
+
+REACTIVE_DOMAIN(D, react::sequential)
+
+void run(const std::string& name, const std::vector<size_t>& input_ids) {
+
+  std::mt19937 rng(42);
+
+  /* Inputs carry their own id */
+  std::vector<std::unique_ptr<IdSetT>> inputs;
+  for(auto id : input_ids) {
+    inputs.emplace_back(new IdSetT());
+    inputs.back()->Insert(id);
+  }
+
+  /* Each node depends on a few random nodes of the previous layer */
+  std::vector<std::vector<std::unique_ptr<IdSetT>>> layers(LAYER_COUNT);
+  std::vector<std::vector<std::vector<size_t>>> predecessors(LAYER_COUNT);
+
+  for(size_t l = 0; l < LAYER_COUNT; ++l) {
+    const auto prev_width = l == 0 ? INPUT_COUNT : LAYER_WIDTH;
+    std::uniform_int_distribution<size_t> pick(0, prev_width - 1);
+
+    for(size_t n = 0; n < LAYER_WIDTH; ++n) {
+      layers[l].emplace_back(new IdSetT());
+      predecessors[l].emplace_back();
+
+      for(size_t p = 0; p < PREDECESSOR_COUNT; ++p)
+        predecessors[l].back().push_back(pick(rng));
+    }
+  }
+
+  auto predecessor = [&](size_t l, size_t p) -> IdSetT& {
+    return l == 0 ? *inputs[p] : *layers[l - 1][p];
+  };
+
+  /* Merge predecessor sets into every node */
+  const auto merge_duration = time_run(
+    [&]() {
+      for(size_t l = 0; l < LAYER_COUNT; ++l) {
+        for(size_t n = 0; n < LAYER_WIDTH; ++n) {
+          auto& node = *layers[l][n];
+          node.Clear();
+
+          for(auto p : predecessors[l][n])
+            node.Insert(predecessor(l, p));
+        }
+      }
+    }, RUN_COUNT);
+
+  print_duration("SourceIdSet " + name + " merge graph", merge_duration);
+
+  /* Find the nodes affected by a turn */
+  IdSetT turn_sources;
+  std::uniform_int_distribution<size_t> pick_input(0, INPUT_COUNT - 1);
+  for(size_t i = 0; i < CHANGED_INPUT_COUNT; ++i)
+    turn_sources.Insert(input_ids[pick_input(rng)]);
+
+  size_t affected = 0;
+  const auto intersect_duration = time_run(
+    [&]() {
+      affected = 0;
+      for(auto& layer : layers)
+        for(auto& node : layer)
+          if (node->IntersectsWith(turn_sources))
+            ++affected;
+    }, RUN_COUNT);
+
+  print_duration("SourceIdSet " + name + " intersect graph", intersect_duration);
+
+  cout << "Nodes: " << LAYER_COUNT * LAYER_WIDTH << ", inputs: " << INPUT_COUNT
+       << ", affected by turn: " << affected << endl;
+}
+
+int main() {
+
+  /* Real input nodes, some of them replaced so indices are recycled */
+  std::vector<react::VarSignal<D, int>> vars;
+  for(size_t i = 0; i < INPUT_COUNT; ++i)
+    vars.push_back(react::MakeVar<D>(0));
+  for(size_t i = 0; i < INPUT_COUNT; i += 2)
+    vars[i] = react::MakeVar<D>(0);
+
+  std::vector<size_t> object_ids;
+  std::vector<size_t> source_indices;
+  for(const auto& var : vars) {
+    const auto& node = *react::impl::GetNodePtr(var);
+    object_ids.push_back(react::impl::GetObjectId(node));
+    source_indices.push_back(dynamic_cast<const react::impl::IInputNode&>(node).SourceIndex());
+  }
+
+  run("object id", object_ids);
+  run("source index", source_indices);
+
+  /* exit */
+  return 0;
+
+}
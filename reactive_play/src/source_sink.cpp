@@ -41,6 +41,34 @@ int main() {
 
   print_duration("Observable", observable_duration);
 
+  /* Observable Example, observers stored without std::function */
+  observable::inline_subject<void(Foo)> inline_subject;
+  inline_subject.subscribe(consume);
+
+  const auto observable_inline_duration = time_run(
+    [&inline_subject]() {
+      for(auto i = 0; i < LOOP_COUNT; ++i) {
+        inline_subject.notify(Foo(i));
+      }
+    });
+
+  print_duration("Observable inline", observable_inline_duration);
+
+  /* Observable Example, all observers of one known type */
+  const auto observer = [](Foo f) { consume(f); };
+
+  observable::typed_subject<void(Foo), decltype(observer)> typed_subject;
+  typed_subject.subscribe(observer);
+
+  const auto observable_typed_duration = time_run(
+    [&typed_subject]() {
+      for(auto i = 0; i < LOOP_COUNT; ++i) {
+        typed_subject.notify(Foo(i));
+      }
+    });
+
+  print_duration("Observable typed", observable_typed_duration);
+
   /* frp example */
   const auto source(frp::stat::push::source<Foo>());
   const auto sink(frp::stat::push::sink(std::ref(source)));
@@ -117,6 +145,8 @@ int main() {
   cout << endl;
 
   print_duration_diff("Simple function", simple_duration, "Observable", observable_duration);
+  print_duration_diff("Simple function", simple_duration, "Observable inline", observable_inline_duration);
+  print_duration_diff("Simple function", simple_duration, "Observable typed", observable_typed_duration);
   print_duration_diff("Simple function", simple_duration, "frp", frp_duration);
   print_duration_diff("Simple function", simple_duration, "Boost", boost_duration);
   print_duration_diff("Simple function", simple_duration, "CppReact", react_duration);
@@ -0,0 +1,76 @@
+/*
+ * The `ReactiveValues` use case again, but the value now goes through a small
+ * graph of functions that is fully known at compile time
+ *
+ *   s = merge(a, b)
+ *   t = merge(s, a)
+ *   u = merge(s, b)
+ *   c = merge(t, u)
+ *
+ * We compare a graph of CppReact signals with the same graph compiled into a single node
+ */
+
+#include <react/react.h>
+
+#include "data_types.h"
+#include "utility.h"
+
+Foo merge(Foo a, Foo b) { return Foo(a.getData() + b.getData()); }
+
+/** cpp react stuff */
+REACTIVE_DOMAIN(Dynamic, react::sequential)
+REACTIVE_DOMAIN(Static, react::sequential)
+
+int main() {
+
+  /** CppReact example **/
+  react::VarSignal<Dynamic, Foo> a_signal = react::MakeVar<Dynamic>(Foo(0));
+  react::VarSignal<Dynamic, Foo> b_signal = react::MakeVar<Dynamic>(Foo(0));
+
+  react::Signal<Dynamic, Foo> s_signal = react::MakeSignal<Dynamic>(With(a_signal, b_signal), merge);
+  react::Signal<Dynamic, Foo> t_signal = react::MakeSignal<Dynamic>(With(s_signal, a_signal), merge);
+  react::Signal<Dynamic, Foo> u_signal = react::MakeSignal<Dynamic>(With(s_signal, b_signal), merge);
+  react::Signal<Dynamic, Foo> c_signal = react::MakeSignal<Dynamic>(With(t_signal, u_signal), merge);
+  react::Observe(c_signal, consume);
+
+  const auto react_duration = time_run(
+    [&a_signal, &b_signal]() {
+      for(size_t i = 0; i < LOOP_COUNT; ++i) {
+        a_signal <<= Foo(static_cast<int>(i % 3));
+        b_signal <<= Foo(static_cast<int>(i % 5));
+      }
+    });
+
+  print_duration("CppReact", react_duration);
+
+  /** CppReact static graph example **/
+  react::VarSignal<Static, Foo> a_static = react::MakeVar<Static>(Foo(0));
+  react::VarSignal<Static, Foo> b_static = react::MakeVar<Static>(Foo(0));
+
+  /* slots: 0 = a, 1 = b, 2 = s, 3 = t, 4 = u */
+  react::Signal<Static, Foo> c_static = react::MakeStaticSignal<Static>(With(a_static, b_static),
+    react::Stage<0, 1>(merge),
+    react::Stage<2, 0>(merge),
+    react::Stage<2, 1>(merge),
+    react::Stage<3, 4>(merge));
+  react::Observe(c_static, consume);
+
+  const auto static_duration = time_run(
+    [&a_static, &b_static]() {
+      for(size_t i = 0; i < LOOP_COUNT; ++i) {
+        a_static <<= Foo(static_cast<int>(i % 3));
+        b_static <<= Foo(static_cast<int>(i % 5));
+      }
+    });
+
+  print_duration("CppReact static", static_duration);
+
+  /* stats */
+  cout << endl;
+
+  print_duration_diff("CppReact static", static_duration, "CppReact", react_duration);
+
+  /* exit */
+  return 0;
+
+}
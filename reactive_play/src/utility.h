@@ -14,16 +14,21 @@ static unsigned long const REPEAT_COUNT = 1'000;
 void consume(Foo f) { f(); }
 
 template <typename Function>
-inline auto time_run(Function && function) {
+inline auto time_run(Function && function, unsigned long repeat_count) {
   auto start = std::chrono::high_resolution_clock::now();
 
-  for(auto i = REPEAT_COUNT; i > 0; --i) {
+  for(auto i = repeat_count; i > 0; --i) {
     function();
   }
 
   auto end = std::chrono::high_resolution_clock::now();
 
-  return (end - start) / REPEAT_COUNT;
+  return (end - start) / repeat_count;
+}
+
+template <typename Function>
+inline auto time_run(Function && function) {
+  return time_run(std::forward<Function>(function), REPEAT_COUNT);
 }
 
 
@@ -36,5 +41,11 @@ inline auto print_duration(std::string name, std::chrono::nanoseconds duration)
 inline auto print_duration_diff(std::string first_name, std::chrono::nanoseconds first_duration,
                                 std::string second_name, std::chrono::nanoseconds second_duration) {
 
-  cout << second_name << " / " << first_name << " : " << second_duration / first_duration << endl;
+  cout << second_name << " / " << first_name << " : ";
+
+  /* optimized builds can reduce the baseline to nothing */
+  if(first_duration.count() == 0)
+    cout << "n/a" << endl;
+  else
+    cout << second_duration / first_duration << endl;
 }
\ No newline at end of file